@@ -0,0 +1,300 @@
+/* Модуль Python s21matrix поверх C-интерфейса s21_matrix_c.h.
+ * Matrix(obj) оборачивает двумерный буфер float64 без копирования,
+ * сама Matrix тоже отдаёт данные через протокол буфера, поэтому
+ * numpy.asarray(matrix) и Matrix(array) делят одну память. Умножение и
+ * обращение выполняются без GIL. */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <limits.h>
+#include <string.h>
+
+#include "s21_matrix_c.h"
+
+#define ITEM_SIZE ((Py_ssize_t)sizeof(double))
+
+typedef struct {
+  PyObject_HEAD
+  s21_matrix* matrix;
+  /* Буфер, поверх которого создана матрица, держится до её удаления */
+  Py_buffer source;
+  int hasSource;
+  int readonly;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+} MatrixObject;
+
+static PyTypeObject MatrixType;
+
+static PyObject* SetError(s21_matrix_status status) {
+  PyObject* type = PyExc_RuntimeError;
+  if (status == S21_MATRIX_INVALID_ARGUMENT) {
+    type = PyExc_ValueError;
+  } else if (status == S21_MATRIX_OUT_OF_RANGE) {
+    type = PyExc_IndexError;
+  } else if (status == S21_MATRIX_NO_MEMORY) {
+    type = PyExc_MemoryError;
+  }
+  PyErr_SetString(type, s21_matrix_last_error());
+  return NULL;
+}
+
+static MatrixObject* NewMatrix(PyTypeObject* type) {
+  MatrixObject* self = (MatrixObject*)type->tp_alloc(type, 0);
+  if (self != NULL) {
+    self->matrix = NULL;
+    self->hasSource = 0;
+    self->readonly = 0;
+  }
+  return self;
+}
+
+static PyObject* WrapResult(s21_matrix* matrix) {
+  MatrixObject* self = NewMatrix(&MatrixType);
+  if (self == NULL) {
+    s21_matrix_free(matrix);
+  } else {
+    self->matrix = matrix;
+  }
+  return (PyObject*)self;
+}
+
+static int IsDoubleFormat(const char* format) {
+  /* Порядок байт "<" допустим только на little-endian машинах */
+  return format != NULL &&
+         (strcmp(format, "d") == 0 || strcmp(format, "=d") == 0 ||
+          strcmp(format, "@d") == 0 ||
+          (PY_LITTLE_ENDIAN && strcmp(format, "<d") == 0));
+}
+
+static int FromBuffer(MatrixObject* self, PyObject* object) {
+  int flags = PyBUF_STRIDES | PyBUF_FORMAT;
+  if (PyObject_GetBuffer(object, &self->source, flags | PyBUF_WRITABLE) < 0) {
+    PyErr_Clear();
+    if (PyObject_GetBuffer(object, &self->source, flags) < 0) return -1;
+    self->readonly = 1;
+  }
+  self->hasSource = 1;
+  Py_buffer* view = &self->source;
+  if (view->ndim != 2 || view->itemsize != ITEM_SIZE ||
+      !IsDoubleFormat(view->format) || view->shape[0] > INT_MAX ||
+      view->shape[1] > INT_MAX) {
+    PyErr_SetString(PyExc_ValueError,
+                    "expected a two-dimensional float64 buffer");
+    return -1;
+  }
+  int rows = (int)view->shape[0];
+  int cols = (int)view->shape[1];
+  Py_ssize_t stride = rows > 1 ? view->strides[0] : cols * ITEM_SIZE;
+  if ((cols > 1 && view->strides[1] != ITEM_SIZE) ||
+      stride % ITEM_SIZE != 0 ||
+      stride / ITEM_SIZE > INT_MAX) {
+    PyErr_SetString(PyExc_ValueError,
+                    "buffer rows must be contiguous and aligned");
+    return -1;
+  }
+  s21_matrix_status status =
+      s21_matrix_wrap((double*)view->buf, rows, cols,
+                      (int)(stride / ITEM_SIZE),
+                      &self->matrix);
+  return status == S21_MATRIX_OK ? 0 : (SetError(status), -1);
+}
+
+static PyObject* Matrix_new(PyTypeObject* type, PyObject* args,
+                            PyObject* kwargs) {
+  static char* keywords[] = {"source", "cols", NULL};
+  PyObject* source = NULL;
+  int cols = -1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", keywords, &source,
+                                   &cols)) {
+    return NULL;
+  }
+  MatrixObject* self = NewMatrix(type);
+  if (self == NULL) return NULL;
+  int failed = 0;
+  if (cols >= 0 || PyLong_Check(source)) {
+    /* Matrix(rows, cols) - нулевая матрица */
+    int rows = (int)PyLong_AsLong(source);
+    if (PyErr_Occurred()) {
+      failed = 1;
+    } else {
+      s21_matrix_status status = s21_matrix_create(rows, cols, &self->matrix);
+      failed = status != S21_MATRIX_OK;
+      if (failed) SetError(status);
+    }
+  } else {
+    failed = FromBuffer(self, source) < 0;
+  }
+  if (failed) {
+    Py_DECREF(self);
+    self = NULL;
+  }
+  return (PyObject*)self;
+}
+
+static void Matrix_dealloc(MatrixObject* self) {
+  s21_matrix_free(self->matrix);
+  if (self->hasSource) PyBuffer_Release(&self->source);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static int Matrix_getbuffer(MatrixObject* self, Py_buffer* view, int flags) {
+  if ((flags & PyBUF_WRITABLE) && self->readonly) {
+    PyErr_SetString(PyExc_BufferError, "matrix wraps a read-only buffer");
+    return -1;
+  }
+  int rows = s21_matrix_rows(self->matrix);
+  int cols = s21_matrix_cols(self->matrix);
+  int stride = s21_matrix_stride(self->matrix);
+  /* Одна строка или один столбец без отступа смежны в обоих порядках */
+  int cContiguous = stride == cols || rows == 1;
+  int fContiguous = rows == 1 || (cols == 1 && stride == 1);
+  int contiguous = cContiguous;
+  if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS) {
+    contiguous = fContiguous;
+  } else if ((flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS) {
+    contiguous = cContiguous || fContiguous;
+  } else if ((flags & PyBUF_STRIDES) == PyBUF_STRIDES &&
+             (flags & PyBUF_C_CONTIGUOUS) != PyBUF_C_CONTIGUOUS) {
+    contiguous = 1;
+  }
+  if (!contiguous) {
+    PyErr_SetString(PyExc_BufferError, "matrix rows are not contiguous");
+    return -1;
+  }
+  self->shape[0] = rows;
+  self->shape[1] = cols;
+  self->strides[0] = stride * ITEM_SIZE;
+  self->strides[1] = ITEM_SIZE;
+  view->buf = s21_matrix_data(self->matrix);
+  view->obj = (PyObject*)self;
+  Py_INCREF(self);
+  view->len = (Py_ssize_t)rows * cols * ITEM_SIZE;
+  view->readonly = self->readonly;
+  view->itemsize = ITEM_SIZE;
+  view->format = (flags & PyBUF_FORMAT) ? "d" : NULL;
+  view->ndim = 2;
+  view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+  view->strides =
+      (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  return 0;
+}
+
+/* Matrix или любой объект с двумерным буфером float64, новая ссылка */
+static MatrixObject* AsMatrix(PyObject* object) {
+  if (PyObject_TypeCheck(object, &MatrixType)) {
+    Py_INCREF(object);
+    return (MatrixObject*)object;
+  }
+  PyObject* args = PyTuple_Pack(1, object);
+  if (args == NULL) return NULL;
+  MatrixObject* result = (MatrixObject*)Matrix_new(&MatrixType, args, NULL);
+  Py_DECREF(args);
+  return result;
+}
+
+static PyObject* Matrix_multiply(MatrixObject* self, PyObject* other) {
+  MatrixObject* right = AsMatrix(other);
+  if (right == NULL) return NULL;
+  s21_matrix* result = NULL;
+  s21_matrix_status status;
+  Py_BEGIN_ALLOW_THREADS;
+  status = s21_matrix_multiply(self->matrix, right->matrix, &result);
+  Py_END_ALLOW_THREADS;
+  Py_DECREF(right);
+  return status == S21_MATRIX_OK ? WrapResult(result) : SetError(status);
+}
+
+static PyObject* Matrix_matmul(PyObject* left, PyObject* right) {
+  MatrixObject* matrix = AsMatrix(left);
+  if (matrix == NULL) return NULL;
+  PyObject* result = Matrix_multiply(matrix, right);
+  Py_DECREF(matrix);
+  return result;
+}
+
+static PyObject* Matrix_inverse(MatrixObject* self,
+                                PyObject* Py_UNUSED(ignored)) {
+  s21_matrix* result = NULL;
+  s21_matrix_status status;
+  Py_BEGIN_ALLOW_THREADS;
+  status = s21_matrix_inverse(self->matrix, &result);
+  Py_END_ALLOW_THREADS;
+  return status == S21_MATRIX_OK ? WrapResult(result) : SetError(status);
+}
+
+static PyObject* Matrix_determinant(MatrixObject* self,
+                                    PyObject* Py_UNUSED(ignored)) {
+  double result = 0;
+  s21_matrix_status status;
+  Py_BEGIN_ALLOW_THREADS;
+  status = s21_matrix_determinant(self->matrix, &result);
+  Py_END_ALLOW_THREADS;
+  return status == S21_MATRIX_OK ? PyFloat_FromDouble(result)
+                                 : SetError(status);
+}
+
+static PyObject* Matrix_getshape(MatrixObject* self, void* Py_UNUSED(closure)) {
+  return Py_BuildValue("(ii)", s21_matrix_rows(self->matrix),
+                       s21_matrix_cols(self->matrix));
+}
+
+static PyMethodDef MatrixMethods[] = {
+    {"multiply", (PyCFunction)Matrix_multiply, METH_O,
+     "Matrix product, computed without holding the GIL."},
+    {"inverse", (PyCFunction)Matrix_inverse, METH_NOARGS,
+     "Inverse matrix, computed without holding the GIL."},
+    {"determinant", (PyCFunction)Matrix_determinant, METH_NOARGS,
+     "Determinant of a square matrix."},
+    {NULL, NULL, 0, NULL}};
+
+static PyGetSetDef MatrixGetSet[] = {
+    {"shape", (getter)Matrix_getshape, NULL, "(rows, cols)", NULL},
+    {NULL, NULL, NULL, NULL, NULL}};
+
+static PyNumberMethods MatrixNumber = {.nb_matrix_multiply = Matrix_matmul};
+
+static PyBufferProcs MatrixBuffer = {
+    .bf_getbuffer = (getbufferproc)Matrix_getbuffer,
+    .bf_releasebuffer = NULL};
+
+static PyTypeObject MatrixType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "s21matrix.Matrix",
+    .tp_doc = "Matrix(source) wraps a 2-D float64 buffer without copying; "
+              "Matrix(rows, cols) creates a zero matrix.",
+    .tp_basicsize = sizeof(MatrixObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = Matrix_new,
+    .tp_dealloc = (destructor)Matrix_dealloc,
+    .tp_methods = MatrixMethods,
+    .tp_getset = MatrixGetSet,
+    .tp_as_number = &MatrixNumber,
+    .tp_as_buffer = &MatrixBuffer};
+
+static struct PyModuleDef Module = {.m_base = PyModuleDef_HEAD_INIT,
+                                    .m_name = "s21matrix",
+                                    .m_doc = "Bindings for S21Matrix.",
+                                    .m_size = -1,
+                                    .m_methods = NULL,
+                                    .m_slots = NULL,
+                                    .m_traverse = NULL,
+                                    .m_clear = NULL,
+                                    .m_free = NULL};
+
+PyMODINIT_FUNC PyInit_s21matrix(void) {
+  if (PyType_Ready(&MatrixType) < 0) return NULL;
+  PyObject* module = PyModule_Create(&Module);
+  if (module == NULL) return NULL;
+  Py_INCREF(&MatrixType);
+  if (PyModule_AddObject(module, "Matrix", (PyObject*)&MatrixType) < 0 ||
+      PyModule_AddIntConstant(module, "ABI_VERSION",
+                              s21_matrix_abi_version()) < 0) {
+    Py_DECREF(&MatrixType);
+    Py_DECREF(module);
+    return NULL;
+  }
+  return module;
+}
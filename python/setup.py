@@ -0,0 +1,31 @@
+"""Сборка модуля s21matrix.
+
+python3 setup.py build_clib build_ext --inplace
+"""
+
+from pathlib import Path
+
+from setuptools import Extension, setup
+
+ROOT = Path(__file__).resolve().parent.parent
+LIBRARY = sorted(str(path) for path in ROOT.glob("s21_matrix*.cc")
+                 if "test" not in path.name)
+
+setup(
+    name="s21matrix",
+    version="1.0",
+    # Библиотека на C++17 собирается отдельно, модуль остаётся на C
+    libraries=[
+        ("s21_matrix", {"sources": LIBRARY, "cflags": ["-std=c++17"]}),
+    ],
+    ext_modules=[
+        Extension(
+            "s21matrix",
+            sources=["s21_matrix_module.c"],
+            include_dirs=[str(ROOT)],
+            extra_compile_args=["-Wall", "-Wextra"],
+            extra_link_args=["-pthread"],
+            language="c++",
+        )
+    ],
+)
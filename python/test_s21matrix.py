@@ -0,0 +1,87 @@
+"""Проверки модуля s21matrix: make python_test."""
+
+import array
+import importlib.util
+import io
+import unittest
+
+import s21matrix
+
+HAS_NUMPY = importlib.util.find_spec("numpy") is not None
+
+
+def Buffer(values, rows, cols):
+    """Двумерный memoryview float64 поверх array."""
+    return memoryview(array.array("d", values)).cast("B").cast(
+        "d", (rows, cols))
+
+
+class MatrixTests(unittest.TestCase):
+    def test_wraps_buffer_without_copy(self):
+        source = Buffer([1, 2, 3, 4, 5, 6], 2, 3)
+        matrix = s21matrix.Matrix(source)
+        self.assertEqual(matrix.shape, (2, 3))
+        view = memoryview(matrix)
+        self.assertEqual(view.shape, (2, 3))
+        self.assertEqual(view.strides, (24, 8))
+        view[1, 2] = 10
+        self.assertEqual(source[1, 2], 10)
+        source[0, 0] = -1
+        self.assertEqual(view[0, 0], -1)
+
+    def test_zero_matrix(self):
+        view = memoryview(s21matrix.Matrix(2, 2))
+        self.assertEqual(view.tolist(), [[0, 0], [0, 0]])
+
+    @unittest.skipUnless(HAS_NUMPY, "срезы с шагом строятся через numpy")
+    def test_strided_source(self):
+        import numpy
+
+        # Строки с шагом 4 элемента: отступ не входит в матрицу
+        padded = numpy.array([[1, 2, -1, -1], [3, 4, -1, -1]], dtype="d")
+        matrix = s21matrix.Matrix(padded[:, :2])
+        view = memoryview(matrix)
+        self.assertEqual(view.shape, (2, 2))
+        self.assertEqual(view.strides, (32, 8))
+        self.assertFalse(view.c_contiguous)
+        self.assertEqual(view.tolist(), [[1, 2], [3, 4]])
+        self.assertEqual(numpy.asarray(matrix).strides, (32, 8))
+        self.assertEqual(memoryview(matrix @ matrix).tolist(),
+                         [[7, 10], [15, 22]])
+        # Потребитель без поддержки шагов не должен читать отступ
+        with self.assertRaises(BufferError):
+            array.array("d").frombytes(matrix)
+        self.assertEqual(padded[0, 3], -1)
+
+    def test_product_and_inverse(self):
+        left = s21matrix.Matrix(Buffer([2, 0, 0, 4], 2, 2))
+        self.assertEqual(memoryview(left.inverse()).tolist(),
+                         [[0.5, 0], [0, 0.25]])
+        self.assertEqual(left.determinant(), 8)
+        product = left @ Buffer([1, 1, 1, 1], 2, 2)
+        self.assertEqual(memoryview(product).tolist(), [[2, 2], [4, 4]])
+
+    def test_readonly_source(self):
+        source = Buffer([1, 2, 3, 4], 2, 2).toreadonly()
+        matrix = s21matrix.Matrix(source)
+        self.assertTrue(memoryview(matrix).readonly)
+        # readinto запрашивает буфер на запись и получает отказ
+        with self.assertRaises(TypeError):
+            io.BytesIO(bytes(32)).readinto(matrix)
+        self.assertEqual(matrix.determinant(), -2)
+
+    def test_errors(self):
+        with self.assertRaises(ValueError):
+            s21matrix.Matrix(Buffer([1, 2, 3, 4], 1, 4).cast("B"))
+        with self.assertRaises(ValueError):
+            s21matrix.Matrix(0, 2)
+        with self.assertRaises(ValueError):
+            s21matrix.Matrix(2, 3) @ s21matrix.Matrix(2, 3)
+        with self.assertRaises(ValueError):
+            s21matrix.Matrix(2, 3).determinant()
+        with self.assertRaises(RuntimeError):
+            s21matrix.Matrix(2, 2).inverse()
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,204 @@
+#include "s21_matrix_async.h"
+
+#include <chrono>
+#include <mutex>
+#include <utility>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_executor.h"
+
+S21MatrixProgress::S21MatrixProgress()
+    : cancelled_(false), done_(0), total_(0) {}
+
+void S21MatrixProgress::Cancel() { cancelled_ = true; }
+
+bool S21MatrixProgress::IsCancelled() const { return cancelled_; }
+
+void S21MatrixProgress::SetTotal(long total) {
+  done_ = 0;
+  total_ = total;
+}
+
+void S21MatrixProgress::Report(long done) {
+  S21MatrixException::CheckCancelled(cancelled_);
+  done_ = done;
+}
+
+void S21MatrixProgress::Complete() {
+  if (total_ <= 0) total_ = 1;
+  done_ = total_.load();
+}
+
+double S21MatrixProgress::GetProgress() const {
+  long total = total_;
+  return total > 0 ? static_cast<double>(done_) / total : 0.0;
+}
+
+struct S21MatrixTask::State {
+  std::promise<S21Matrix> promise;
+  std::shared_future<S21Matrix> future;
+  S21MatrixProgress progress;
+  Operation operation;
+  std::vector<std::shared_ptr<State>> deps;
+  std::atomic<int> pending{0};
+  std::mutex mutex;
+  bool finished = false;
+  std::vector<std::function<void()>> continuations;
+
+  State() : future(promise.get_future().share()) {}
+};
+
+S21MatrixTask::S21MatrixTask(std::shared_ptr<State> state)
+    : state_(std::move(state)) {}
+
+S21MatrixTask S21MatrixTask::Ready(S21Matrix matrix) {
+  auto state = std::make_shared<State>();
+  state->promise.set_value(std::move(matrix));
+  state->progress.Complete();
+  Finish(state);
+  return S21MatrixTask(state);
+}
+
+S21MatrixTask S21MatrixTask::Sum(const S21MatrixTask& a,
+                                 const S21MatrixTask& b) {
+  return Schedule({a, b}, [](const std::vector<const S21Matrix*>& args,
+                             S21MatrixProgress*) {
+    S21Matrix result(*args[0]);
+    result.SumMatrix(*args[1]);
+    return result;
+  });
+}
+
+S21MatrixTask S21MatrixTask::Sub(const S21MatrixTask& a,
+                                 const S21MatrixTask& b) {
+  return Schedule({a, b}, [](const std::vector<const S21Matrix*>& args,
+                             S21MatrixProgress*) {
+    S21Matrix result(*args[0]);
+    result.SubMatrix(*args[1]);
+    return result;
+  });
+}
+
+S21MatrixTask S21MatrixTask::Mul(const S21MatrixTask& a,
+                                 const S21MatrixTask& b) {
+  return Schedule({a, b}, [](const std::vector<const S21Matrix*>& args,
+                             S21MatrixProgress* progress) {
+    return args[0]->Product(*args[1], progress);
+  });
+}
+
+S21MatrixTask S21MatrixTask::MulNumber(const S21MatrixTask& a, double num) {
+  return Schedule({a}, [num](const std::vector<const S21Matrix*>& args,
+                             S21MatrixProgress*) {
+    S21Matrix result(*args[0]);
+    result.MulNumber(num);
+    return result;
+  });
+}
+
+S21MatrixTask S21MatrixTask::Transpose(const S21MatrixTask& a) {
+  return Schedule({a}, [](const std::vector<const S21Matrix*>& args,
+                          S21MatrixProgress*) {
+    return args[0]->Transpose();
+  });
+}
+
+S21MatrixTask S21MatrixTask::Complements(const S21MatrixTask& a) {
+  return Schedule({a}, [](const std::vector<const S21Matrix*>& args,
+                          S21MatrixProgress* progress) {
+    return args[0]->CalcComplements(progress);
+  });
+}
+
+S21MatrixTask S21MatrixTask::Inverse(const S21MatrixTask& a) {
+  return Schedule({a}, [](const std::vector<const S21Matrix*>& args,
+                          S21MatrixProgress* progress) {
+    return args[0]->InverseMatrix(progress);
+  });
+}
+
+S21Matrix S21MatrixTask::Get() const { return state_->future.get(); }
+
+void S21MatrixTask::Wait() const { state_->future.wait(); }
+
+bool S21MatrixTask::IsReady() const {
+  return state_->future.wait_for(std::chrono::seconds(0)) ==
+         std::future_status::ready;
+}
+
+std::shared_future<S21Matrix> S21MatrixTask::GetFuture() const {
+  return state_->future;
+}
+
+void S21MatrixTask::Cancel() { state_->progress.Cancel(); }
+
+bool S21MatrixTask::IsCancelled() const {
+  return state_->progress.IsCancelled();
+}
+
+double S21MatrixTask::GetProgress() const {
+  return state_->progress.GetProgress();
+}
+
+S21MatrixTask S21MatrixTask::Schedule(const std::vector<S21MatrixTask>& deps,
+                                      Operation operation) {
+  auto state = std::make_shared<State>();
+  state->operation = std::move(operation);
+  // Лишняя единица не даёт запустить задачу, пока подписка не завершена
+  state->pending = static_cast<int>(deps.size()) + 1;
+  for (const S21MatrixTask& dep : deps) {
+    state->deps.push_back(dep.state_);
+    OnFinished(dep.state_, [state] {
+      if (--state->pending == 0) {
+        S21MatrixExecutor::Instance().Submit([state] { Run(state); });
+      }
+    });
+  }
+  if (--state->pending == 0) {
+    S21MatrixExecutor::Instance().Submit([state] { Run(state); });
+  }
+  return S21MatrixTask(state);
+}
+
+void S21MatrixTask::Run(const std::shared_ptr<State>& state) {
+  try {
+    S21MatrixException::CheckCancelled(state->progress.IsCancelled());
+    std::vector<const S21Matrix*> args;
+    for (const std::shared_ptr<State>& dep : state->deps) {
+      // Ошибка аргумента передаётся в зависимую задачу
+      args.push_back(&dep->future.get());
+    }
+    S21Matrix result = state->operation(args, &state->progress);
+    // Прогресс завершается до готовности результата, чтобы дождавшийся
+    // его поток видел 1
+    state->progress.Complete();
+    state->promise.set_value(std::move(result));
+  } catch (...) {
+    state->promise.set_exception(std::current_exception());
+  }
+  state->operation = nullptr;
+  state->deps.clear();
+  Finish(state);
+}
+
+void S21MatrixTask::Finish(const std::shared_ptr<State>& state) {
+  std::vector<std::function<void()>> continuations;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->finished = true;
+    continuations.swap(state->continuations);
+  }
+  for (std::function<void()>& continuation : continuations) continuation();
+}
+
+void S21MatrixTask::OnFinished(const std::shared_ptr<State>& state,
+                               std::function<void()> continuation) {
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->finished) {
+      state->continuations.push_back(std::move(continuation));
+      return;
+    }
+  }
+  continuation();
+}
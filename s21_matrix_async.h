@@ -0,0 +1,73 @@
+#ifndef S21_MATRIX_ASYNC_H
+#define S21_MATRIX_ASYNC_H
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Отмена и прогресс долгой операции
+class S21MatrixProgress {
+ public:
+  S21MatrixProgress();
+
+  void Cancel();
+  bool IsCancelled() const;
+  void SetTotal(long total);
+  // Отмечает выполненную часть работы, бросает исключение после отмены
+  void Report(long done);
+  // Отмечает всю работу выполненной, в том числе у операций без отчётов
+  void Complete();
+  double GetProgress() const;
+
+ private:
+  std::atomic<bool> cancelled_;
+  std::atomic<long> done_;
+  std::atomic<long> total_;
+};
+
+// Результат асинхронной операции, выполняемой в S21MatrixExecutor.
+// Задачи можно связывать между собой: зависимая задача ставится в очередь
+// сразу после готовности аргументов, не возвращаясь в вызывающий поток.
+class S21MatrixTask {
+ public:
+  static S21MatrixTask Ready(S21Matrix matrix);
+  static S21MatrixTask Sum(const S21MatrixTask& a, const S21MatrixTask& b);
+  static S21MatrixTask Sub(const S21MatrixTask& a, const S21MatrixTask& b);
+  static S21MatrixTask Mul(const S21MatrixTask& a, const S21MatrixTask& b);
+  static S21MatrixTask MulNumber(const S21MatrixTask& a, double num);
+  static S21MatrixTask Transpose(const S21MatrixTask& a);
+  static S21MatrixTask Complements(const S21MatrixTask& a);
+  static S21MatrixTask Inverse(const S21MatrixTask& a);
+
+  S21Matrix Get() const;
+  void Wait() const;
+  bool IsReady() const;
+  std::shared_future<S21Matrix> GetFuture() const;
+
+  // Отменяет только эту задачу, её аргументы продолжают вычисляться
+  void Cancel();
+  bool IsCancelled() const;
+  double GetProgress() const;
+
+ private:
+  struct State;
+  using Operation = std::function<S21Matrix(
+      const std::vector<const S21Matrix*>& args, S21MatrixProgress* progress)>;
+
+  std::shared_ptr<State> state_;
+
+  explicit S21MatrixTask(std::shared_ptr<State> state);
+
+  static S21MatrixTask Schedule(const std::vector<S21MatrixTask>& deps,
+                                Operation operation);
+  static void Run(const std::shared_ptr<State>& state);
+  static void Finish(const std::shared_ptr<State>& state);
+  static void OnFinished(const std::shared_ptr<State>& state,
+                         std::function<void()> continuation);
+};
+
+#endif
@@ -0,0 +1,276 @@
+#include "s21_matrix_banded.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_executor.h"
+
+S21BandedMatrix::S21BandedMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  S21MatrixException::CheckRows(size);
+  S21MatrixException::CheckBandwidth(lower, upper);
+  // Диагонали дальше size - 1 от главной пусты
+  lower_ = std::min(lower, size - 1);
+  upper_ = std::min(upper, size - 1);
+  data_.assign(static_cast<std::size_t>(size_) * (lower_ + upper_ + 1), 0.0);
+}
+
+S21BandedMatrix S21BandedMatrix::FromMatrix(const S21Matrix& matrix) {
+  S21MatrixException::CheckSquare(matrix.rows_, matrix.cols_);
+  int size = matrix.rows_;
+  int lower = 0;
+  int upper = 0;
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      if (matrix.matrix_[i][j] != 0) {
+        lower = std::max(lower, i - j);
+        upper = std::max(upper, j - i);
+      }
+    }
+  }
+  S21BandedMatrix result(size, lower, upper);
+  for (int j = 0; j < size; ++j) {
+    int last = std::min(size - 1, j + lower);
+    for (int i = std::max(0, j - upper); i <= last; ++i) {
+      result.At(i, j) = matrix.matrix_[i][j];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21BandedMatrix::ToMatrix() const {
+  S21Matrix result = S21Matrix::Zeros(size_, size_);
+  for (int j = 0; j < size_; ++j) {
+    int last = std::min(size_ - 1, j + lower_);
+    for (int i = std::max(0, j - upper_); i <= last; ++i) {
+      result.matrix_[i][j] = At(i, j);
+    }
+  }
+  return result;
+}
+
+int S21BandedMatrix::GetSize() const { return size_; }
+int S21BandedMatrix::GetLower() const { return lower_; }
+int S21BandedMatrix::GetUpper() const { return upper_; }
+
+double S21BandedMatrix::operator()(int row, int col) const {
+  S21MatrixException::CheckRange(row, col, size_, size_);
+  return InBand(row, col) ? At(row, col) : 0.0;
+}
+
+double& S21BandedMatrix::operator()(int row, int col) {
+  S21MatrixException::CheckRange(row, col, size_, size_);
+  S21MatrixException::CheckInBand(InBand(row, col));
+  return At(row, col);
+}
+
+S21BandedMatrix S21BandedMatrix::Multiply(
+    const S21BandedMatrix& other) const {
+  S21MatrixException::CheckMultiplication(size_, other.size_);
+  S21BandedMatrix result(size_, lower_ + other.lower_, upper_ + other.upper_);
+  // Столбец j результата зависит только от столбца j второго множителя
+  auto columns = [this, &other, &result](int from, int to) {
+    for (int j = from; j < to; ++j) {
+      int lastK = std::min(size_ - 1, j + other.lower_);
+      for (int k = std::max(0, j - other.upper_); k <= lastK; ++k) {
+        double factor = other.At(k, j);
+        if (factor == 0) continue;
+        int lastI = std::min(size_ - 1, k + lower_);
+        for (int i = std::max(0, k - upper_); i <= lastI; ++i) {
+          result.At(i, j) += At(i, k) * factor;
+        }
+      }
+    }
+  };
+  long work = static_cast<long>(size_) * (lower_ + upper_ + 1) *
+              (other.lower_ + other.upper_ + 1);
+  if (work >= kParallelWork) {
+    S21MatrixExecutor::Instance().ParallelFor(0, size_, columns);
+  } else {
+    columns(0, size_);
+  }
+  return result;
+}
+
+S21Matrix S21BandedMatrix::Multiply(const S21Matrix& other) const {
+  S21MatrixException::CheckMultiplication(size_, other.rows_);
+  int cols = other.cols_;
+  S21Matrix result = S21Matrix::Zeros(size_, cols);
+  auto rows = [this, &other, &result, cols](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      double* out = result.matrix_[i];
+      int lastK = std::min(size_ - 1, i + upper_);
+      for (int k = std::max(0, i - lower_); k <= lastK; ++k) {
+        double factor = At(i, k);
+        const double* row = other.matrix_[k];
+        for (int j = 0; j < cols; ++j) out[j] += factor * row[j];
+      }
+    }
+  };
+  long work = static_cast<long>(size_) * (lower_ + upper_ + 1) * cols;
+  if (work >= kParallelWork) {
+    S21MatrixExecutor::Instance().ParallelFor(0, size_, rows);
+  } else {
+    rows(0, size_);
+  }
+  return result;
+}
+
+std::vector<double> S21BandedMatrix::Multiply(
+    const std::vector<double>& x) const {
+  S21MatrixException::CheckMultiplication(size_,
+                                          static_cast<int>(x.size()));
+  std::vector<double> result(size_, 0.0);
+  auto rows = [this, &x, &result](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      double sum = 0;
+      int last = std::min(size_ - 1, i + upper_);
+      for (int k = std::max(0, i - lower_); k <= last; ++k) {
+        sum += At(i, k) * x[k];
+      }
+      result[i] = sum;
+    }
+  };
+  if (static_cast<long>(size_) * (lower_ + upper_ + 1) >= kParallelWork) {
+    S21MatrixExecutor::Instance().ParallelFor(0, size_, rows);
+  } else {
+    rows(0, size_);
+  }
+  return result;
+}
+
+S21BandedMatrix S21BandedMatrix::operator*(
+    const S21BandedMatrix& other) const {
+  return Multiply(other);
+}
+
+S21BandedMatrix::LU S21BandedMatrix::Factorize() const {
+  // Обмены строк расширяют U на lower_ диагоналей вверх (как dgbtf2)
+  LU result{S21BandedMatrix(size_, lower_, lower_ + upper_),
+            std::vector<int>(size_), 1};
+  S21BandedMatrix& f = result.factors;
+  for (int j = 0; j < size_; ++j) {
+    int last = std::min(size_ - 1, j + lower_);
+    for (int i = std::max(0, j - upper_); i <= last; ++i) {
+      f.At(i, j) = At(i, j);
+    }
+  }
+
+  int reach = 0;
+  for (int j = 0; j < size_; ++j) {
+    int below = std::min(lower_, size_ - 1 - j);
+    int pivot = j;
+    for (int i = j + 1; i <= j + below; ++i) {
+      if (std::abs(f.At(i, j)) > std::abs(f.At(pivot, j))) pivot = i;
+    }
+    result.pivots[j] = pivot;
+    // Правее reach строки j..j+below ещё нулевые
+    reach = std::max(reach, std::min(size_ - 1, pivot + upper_));
+    // Нулевой столбец оставляет ноль на диагонали U, как в LAPACK
+    if (f.At(pivot, j) == 0) continue;
+    if (pivot != j) {
+      result.sign = -result.sign;
+      for (int c = j; c <= reach; ++c) {
+        std::swap(f.At(j, c), f.At(pivot, c));
+      }
+    }
+    double diagonal = f.At(j, j);
+    for (int i = j + 1; i <= j + below; ++i) f.At(i, j) /= diagonal;
+    for (int c = j + 1; c <= reach; ++c) {
+      double factor = f.At(j, c);
+      if (factor == 0) continue;
+      for (int i = j + 1; i <= j + below; ++i) {
+        f.At(i, c) -= f.At(i, j) * factor;
+      }
+    }
+  }
+  return result;
+}
+
+double S21BandedMatrix::Determinant() const {
+  return Determinant(Factorize());
+}
+
+double S21BandedMatrix::Determinant(const LU& lu) {
+  double result = lu.sign;
+  for (int j = 0; j < lu.factors.size_; ++j) result *= lu.factors.At(j, j);
+  return result;
+}
+
+std::vector<double> S21BandedMatrix::Solve(
+    const std::vector<double>& rhs) const {
+  S21MatrixException::CheckDimensions(size_, 1, static_cast<int>(rhs.size()),
+                                      1);
+  return IsDiagonallyDominantTridiagonal() ? SolveTridiagonal(rhs)
+                                           : Solve(Factorize(), rhs);
+}
+
+std::vector<double> S21BandedMatrix::Solve(const LU& lu,
+                                           const std::vector<double>& rhs) {
+  const S21BandedMatrix& f = lu.factors;
+  int n = f.size_;
+  S21MatrixException::CheckDimensions(n, 1, static_cast<int>(rhs.size()), 1);
+  std::vector<double> x(rhs);
+  // L * y = P * b, обмены применяются в том же порядке, что при разложении
+  for (int j = 0; j < n; ++j) {
+    std::swap(x[j], x[lu.pivots[j]]);
+    int last = std::min(n - 1, j + f.lower_);
+    for (int i = j + 1; i <= last; ++i) x[i] -= f.At(i, j) * x[j];
+  }
+  // U * x = y, столбцы U обходятся подряд
+  for (int j = n - 1; j >= 0; --j) {
+    S21MatrixException::CheckPivot(f.At(j, j));
+    x[j] /= f.At(j, j);
+    for (int i = std::max(0, j - f.upper_); i < j; ++i) {
+      x[i] -= f.At(i, j) * x[j];
+    }
+  }
+  return x;
+}
+
+bool S21BandedMatrix::InBand(int row, int col) const {
+  return row - col <= lower_ && col - row <= upper_;
+}
+
+double& S21BandedMatrix::At(int row, int col) {
+  return data_[static_cast<std::size_t>(col) * (lower_ + upper_ + 1) +
+               upper_ + row - col];
+}
+
+double S21BandedMatrix::At(int row, int col) const {
+  return data_[static_cast<std::size_t>(col) * (lower_ + upper_ + 1) +
+               upper_ + row - col];
+}
+
+bool S21BandedMatrix::IsDiagonallyDominantTridiagonal() const {
+  bool dominant = lower_ == 1 && upper_ == 1;
+  for (int i = 0; dominant && i < size_; ++i) {
+    double off = (i > 0 ? std::abs(At(i, i - 1)) : 0) +
+                 (i + 1 < size_ ? std::abs(At(i, i + 1)) : 0);
+    dominant = std::abs(At(i, i)) > off;
+  }
+  return dominant;
+}
+
+std::vector<double> S21BandedMatrix::SolveTridiagonal(
+    const std::vector<double>& rhs) const {
+  // Прогонка: прямой ход исключает поддиагональ, обратный - наддиагональ
+  std::vector<double> upper(size_, 0.0);
+  std::vector<double> x(rhs);
+  double diagonal = At(0, 0);
+  // Диагональное преобладание гарантирует ненулевые знаменатели
+  for (int i = 0; i < size_; ++i) {
+    if (i > 0) {
+      double sub = At(i, i - 1);
+      diagonal = At(i, i) - sub * upper[i - 1];
+      x[i] -= sub * x[i - 1];
+    }
+    if (i + 1 < size_) upper[i] = At(i, i + 1) / diagonal;
+    x[i] /= diagonal;
+  }
+  for (int i = size_ - 2; i >= 0; --i) x[i] -= upper[i] * x[i + 1];
+  return x;
+}
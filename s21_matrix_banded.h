@@ -0,0 +1,73 @@
+#ifndef S21_MATRIX_BANDED_H
+#define S21_MATRIX_BANDED_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Квадратная ленточная матрица в формате LAPACK: столбец j хранится
+// подряд, элемент (i, j) лежит в data_[j * (lower + upper + 1) + upper +
+// i - j]. Память и умножение O(n * bw), решение и определитель
+// O(n * bw^2).
+class S21BandedMatrix {
+ public:
+  // P * A = L * U. factors хранит U с верхней шириной lower + upper и
+  // множители L под диагональю, pivots[j] - строка, обменянная с j-й
+  struct LU;
+
+  // Нулевая матрица size x size с lower поддиагоналями и upper
+  // наддиагоналями
+  S21BandedMatrix(int size, int lower, int upper);
+
+  // Ширина ленты определяется по ненулевым элементам
+  static S21BandedMatrix FromMatrix(const S21Matrix& matrix);
+  S21Matrix ToMatrix() const;
+
+  int GetSize() const;
+  int GetLower() const;
+  int GetUpper() const;
+
+  // Вне ленты константный доступ возвращает ноль, а изменяемый бросает
+  // исключение
+  double operator()(int row, int col) const;
+  double& operator()(int row, int col);
+
+  S21BandedMatrix Multiply(const S21BandedMatrix& other) const;
+  S21Matrix Multiply(const S21Matrix& other) const;
+  std::vector<double> Multiply(const std::vector<double>& x) const;
+  S21BandedMatrix operator*(const S21BandedMatrix& other) const;
+
+  // Вырожденная матрица разлагается до конца с нулём на диагонали U,
+  // ошибку бросает только решение
+  LU Factorize() const;
+  double Determinant() const;
+  // Трёхдиагональная матрица с диагональным преобладанием решается
+  // прогонкой без выбора ведущего элемента, остальные - через LU
+  std::vector<double> Solve(const std::vector<double>& rhs) const;
+  static std::vector<double> Solve(const LU& lu,
+                                   const std::vector<double>& rhs);
+  static double Determinant(const LU& lu);
+
+ private:
+  int size_;
+  int lower_;
+  int upper_;
+  std::vector<double> data_;
+
+  // С какого объёма работы умножение идёт параллельно
+  static constexpr long kParallelWork = 1L << 16;
+
+  bool InBand(int row, int col) const;
+  double& At(int row, int col);
+  double At(int row, int col) const;
+  bool IsDiagonallyDominantTridiagonal() const;
+  std::vector<double> SolveTridiagonal(const std::vector<double>& rhs) const;
+};
+
+struct S21BandedMatrix::LU {
+  S21BandedMatrix factors;
+  std::vector<int> pivots;
+  int sign;
+};
+
+#endif
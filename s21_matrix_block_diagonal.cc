@@ -0,0 +1,157 @@
+#include "s21_matrix_block_diagonal.h"
+
+#include <algorithm>
+
+#include "s21_matrix_exception.h"
+#include "s21_matrix_executor.h"
+
+S21BlockDiagonalMatrix::S21BlockDiagonalMatrix() : size_(0) {}
+
+S21BlockDiagonalMatrix::S21BlockDiagonalMatrix(
+    const std::vector<S21Matrix>& blocks)
+    : size_(0) {
+  for (const S21Matrix& block : blocks) AddBlock(block);
+}
+
+S21BlockDiagonalMatrix S21BlockDiagonalMatrix::FromMatrix(
+    const S21Matrix& matrix) {
+  S21MatrixException::CheckSquare(matrix.rows_, matrix.cols_);
+  int size = matrix.rows_;
+  // reach[i] - дальний индекс, с которым связан i через ненулевой элемент
+  std::vector<int> reach(size);
+  for (int i = 0; i < size; ++i) reach[i] = i;
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < size; ++j) {
+      int first = std::min(i, j);
+      if (matrix.matrix_[i][j] != 0) {
+        reach[first] = std::max(reach[first], std::max(i, j));
+      }
+    }
+  }
+  S21BlockDiagonalMatrix result;
+  for (int start = 0; start < size;) {
+    int end = reach[start];
+    for (int p = start; p <= end; ++p) end = std::max(end, reach[p]);
+    int blockSize = end - start + 1;
+    S21Matrix block = S21Matrix::Uninitialized(blockSize, blockSize);
+    for (int i = start; i <= end; ++i) {
+      std::copy(matrix.matrix_[i] + start, matrix.matrix_[i] + end + 1,
+                block.matrix_[i - start]);
+    }
+    result.AddBlock(block);
+    start = end + 1;
+  }
+  return result;
+}
+
+S21Matrix S21BlockDiagonalMatrix::ToMatrix() const {
+  S21MatrixException::CheckRows(size_);
+  S21Matrix result = S21Matrix::Zeros(size_, size_);
+  for (int b = 0; b < GetBlockCount(); ++b) {
+    const S21Matrix& block = blocks_[b];
+    int offset = offsets_[b];
+    for (int i = 0; i < block.rows_; ++i) {
+      std::copy(block.matrix_[i], block.matrix_[i] + block.cols_,
+                result.matrix_[offset + i] + offset);
+    }
+  }
+  return result;
+}
+
+void S21BlockDiagonalMatrix::AddBlock(const S21Matrix& block) {
+  S21MatrixException::CheckSquare(block.rows_, block.cols_);
+  blocks_.push_back(block);
+  offsets_.push_back(size_);
+  size_ += block.rows_;
+}
+
+int S21BlockDiagonalMatrix::GetSize() const { return size_; }
+
+int S21BlockDiagonalMatrix::GetBlockCount() const {
+  return static_cast<int>(blocks_.size());
+}
+
+int S21BlockDiagonalMatrix::GetOffset(int index) const {
+  CheckIndex(index);
+  return offsets_[index];
+}
+
+const S21Matrix& S21BlockDiagonalMatrix::GetBlock(int index) const {
+  CheckIndex(index);
+  return blocks_[index];
+}
+
+S21BlockDiagonalMatrix S21BlockDiagonalMatrix::Multiply(
+    const S21BlockDiagonalMatrix& other) const {
+  S21MatrixException::CheckDimensions(GetBlockCount(), 1,
+                                      other.GetBlockCount(), 1);
+  for (int b = 0; b < GetBlockCount(); ++b) {
+    S21MatrixException::CheckMultiplication(blocks_[b].cols_,
+                                            other.blocks_[b].rows_);
+  }
+  std::vector<S21Matrix> products(GetBlockCount(), S21Matrix(1, 1));
+  ForBlocks([this, &other, &products](int b) {
+    products[b] = S21Matrix::Gemm(blocks_[b], false, other.blocks_[b], false,
+                                  nullptr);
+  });
+  return S21BlockDiagonalMatrix(products);
+}
+
+S21Matrix S21BlockDiagonalMatrix::Multiply(const S21Matrix& other) const {
+  S21MatrixException::CheckMultiplication(size_, other.rows_);
+  int cols = other.cols_;
+  S21Matrix result = S21Matrix::Uninitialized(size_, cols);
+  // Блок умножается только на свою полосу строк второго множителя
+  ForBlocks([this, &other, &result, cols](int b) {
+    const S21Matrix& block = blocks_[b];
+    int offset = offsets_[b];
+    S21Matrix::MulKernel(block.matrix_[0], block.GetStride(),
+                         other.matrix_[offset], other.GetStride(),
+                         result.matrix_[offset], block.rows_, block.cols_,
+                         cols);
+  });
+  return result;
+}
+
+S21BlockDiagonalMatrix S21BlockDiagonalMatrix::operator*(
+    const S21BlockDiagonalMatrix& other) const {
+  return Multiply(other);
+}
+
+double S21BlockDiagonalMatrix::Determinant() const {
+  std::vector<double> determinants(GetBlockCount(), 0.0);
+  ForBlocks([this, &determinants](int b) {
+    determinants[b] = blocks_[b].Determinant();
+  });
+  double result = 1;
+  for (double det : determinants) result *= det;
+  return result;
+}
+
+S21BlockDiagonalMatrix S21BlockDiagonalMatrix::InverseMatrix() const {
+  std::vector<S21Matrix> inverses(GetBlockCount(), S21Matrix(1, 1));
+  ForBlocks([this, &inverses](int b) {
+    inverses[b] = blocks_[b].InverseMatrix();
+  });
+  return S21BlockDiagonalMatrix(inverses);
+}
+
+void S21BlockDiagonalMatrix::CheckIndex(int index) const {
+  S21MatrixException::CheckRange(index, 0, GetBlockCount(), 1);
+}
+
+void S21BlockDiagonalMatrix::ForBlocks(
+    const std::function<void(int)>& body) const {
+  long work = 0;
+  for (const S21Matrix& block : blocks_) {
+    work += static_cast<long>(block.rows_) * block.rows_ * block.rows_;
+  }
+  auto range = [&body](int from, int to) {
+    for (int b = from; b < to; ++b) body(b);
+  };
+  if (GetBlockCount() > 1 && work >= kParallelWork) {
+    S21MatrixExecutor::Instance().ParallelFor(0, GetBlockCount(), range);
+  } else {
+    range(0, GetBlockCount());
+  }
+}
@@ -0,0 +1,48 @@
+#ifndef S21_MATRIX_BLOCK_DIAGONAL_H
+#define S21_MATRIX_BLOCK_DIAGONAL_H
+
+#include <functional>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Блочно-диагональная матрица из квадратных плотных блоков. Операции
+// выполняются поблочно, независимые блоки распределяются по
+// S21MatrixExecutor.
+class S21BlockDiagonalMatrix {
+ public:
+  S21BlockDiagonalMatrix();
+  explicit S21BlockDiagonalMatrix(const std::vector<S21Matrix>& blocks);
+
+  // Разбиение на наименьшие блоки, между которыми нет ненулевых элементов
+  static S21BlockDiagonalMatrix FromMatrix(const S21Matrix& matrix);
+  S21Matrix ToMatrix() const;
+
+  void AddBlock(const S21Matrix& block);
+  int GetSize() const;
+  int GetBlockCount() const;
+  // Номер строки, с которой начинается блок
+  int GetOffset(int index) const;
+  const S21Matrix& GetBlock(int index) const;
+
+  // Блоки множителей должны совпадать по размерам
+  S21BlockDiagonalMatrix Multiply(const S21BlockDiagonalMatrix& other) const;
+  S21Matrix Multiply(const S21Matrix& other) const;
+  S21BlockDiagonalMatrix operator*(const S21BlockDiagonalMatrix& other) const;
+  double Determinant() const;
+  S21BlockDiagonalMatrix InverseMatrix() const;
+
+ private:
+  std::vector<S21Matrix> blocks_;
+  std::vector<int> offsets_;
+  int size_;
+
+  // С какого суммарного объёма работы блоки обрабатываются параллельно
+  static constexpr long kParallelWork = 1L << 16;
+
+  void CheckIndex(int index) const;
+  // Выполняет body для каждого блока, для больших матриц - параллельно
+  void ForBlocks(const std::function<void(int)>& body) const;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "s21_matrix_c.h"
+
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+struct s21_matrix {
+  S21Matrix value;
+};
+
+static thread_local std::string lastError;
+
+// Исключения не должны пересекать границу C, они превращаются в коды
+template <typename Body>
+static s21_matrix_status Guard(Body body) {
+  s21_matrix_status status = S21_MATRIX_OK;
+  try {
+    body();
+    lastError.clear();
+  } catch (const std::bad_alloc& error) {
+    status = S21_MATRIX_NO_MEMORY;
+    lastError = error.what();
+  } catch (const std::out_of_range& error) {
+    status = S21_MATRIX_OUT_OF_RANGE;
+    lastError = error.what();
+  } catch (const std::invalid_argument& error) {
+    status = S21_MATRIX_INVALID_ARGUMENT;
+    lastError = error.what();
+  } catch (const std::exception& error) {
+    status = S21_MATRIX_RUNTIME_ERROR;
+    lastError = error.what();
+  }
+  return status;
+}
+
+static void CheckArgument(const void* pointer) {
+  if (pointer == nullptr) {
+    throw std::invalid_argument("Null pointer argument");
+  }
+}
+
+int s21_matrix_abi_version(void) { return S21_MATRIX_ABI_VERSION; }
+
+const char* s21_matrix_last_error(void) { return lastError.c_str(); }
+
+s21_matrix_status s21_matrix_create(int rows, int cols, s21_matrix** result) {
+  return Guard([rows, cols, result] {
+    CheckArgument(result);
+    *result = new s21_matrix{S21Matrix::Zeros(rows, cols)};
+  });
+}
+
+s21_matrix_status s21_matrix_wrap(double* data, int rows, int cols,
+                                  int stride, s21_matrix** result) {
+  return Guard([data, rows, cols, stride, result] {
+    CheckArgument(result);
+    *result = new s21_matrix{S21Matrix::Wrap(data, rows, cols, stride)};
+  });
+}
+
+void s21_matrix_free(s21_matrix* matrix) { delete matrix; }
+
+int s21_matrix_rows(const s21_matrix* matrix) {
+  return matrix != nullptr ? matrix->value.GetRows() : 0;
+}
+
+int s21_matrix_cols(const s21_matrix* matrix) {
+  return matrix != nullptr ? matrix->value.GetCols() : 0;
+}
+
+int s21_matrix_stride(const s21_matrix* matrix) {
+  return matrix != nullptr ? matrix->value.GetStride() : 0;
+}
+
+double* s21_matrix_data(s21_matrix* matrix) {
+  // Блок помечается открытым: хеш не кешируется, поздняя запись не устаревает
+  return matrix != nullptr ? matrix->value.Data() : nullptr;
+}
+
+s21_matrix_status s21_matrix_multiply(const s21_matrix* a,
+                                      const s21_matrix* b,
+                                      s21_matrix** result) {
+  return Guard([a, b, result] {
+    CheckArgument(a);
+    CheckArgument(b);
+    CheckArgument(result);
+    *result = new s21_matrix{a->value * b->value};
+  });
+}
+
+s21_matrix_status s21_matrix_inverse(const s21_matrix* matrix,
+                                     s21_matrix** result) {
+  return Guard([matrix, result] {
+    CheckArgument(matrix);
+    CheckArgument(result);
+    *result = new s21_matrix{matrix->value.InverseMatrix()};
+  });
+}
+
+s21_matrix_status s21_matrix_determinant(const s21_matrix* matrix,
+                                         double* result) {
+  return Guard([matrix, result] {
+    CheckArgument(matrix);
+    CheckArgument(result);
+    *result = matrix->value.Determinant();
+  });
+}
@@ -0,0 +1,58 @@
+#ifndef S21_MATRIX_C_H
+#define S21_MATRIX_C_H
+
+/* Стабильный C-интерфейс к S21Matrix. Матрица - непрозрачный указатель,
+ * элементы лежат по строкам с шагом s21_matrix_stride. Ошибки
+ * возвращаются кодом, текст последней ошибки потока - через
+ * s21_matrix_last_error. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define S21_MATRIX_ABI_VERSION 1
+
+typedef struct s21_matrix s21_matrix;
+
+typedef enum {
+  S21_MATRIX_OK = 0,
+  S21_MATRIX_INVALID_ARGUMENT = 1,
+  S21_MATRIX_OUT_OF_RANGE = 2,
+  S21_MATRIX_RUNTIME_ERROR = 3,
+  S21_MATRIX_NO_MEMORY = 4
+} s21_matrix_status;
+
+int s21_matrix_abi_version(void);
+const char* s21_matrix_last_error(void);
+
+/* Нулевая матрица rows x cols */
+s21_matrix_status s21_matrix_create(int rows, int cols, s21_matrix** result);
+/* Матрица поверх буфера вызывающего без копирования, буфер должен жить
+ * дольше матрицы */
+s21_matrix_status s21_matrix_wrap(double* data, int rows, int cols,
+                                  int stride, s21_matrix** result);
+void s21_matrix_free(s21_matrix* matrix);
+
+int s21_matrix_rows(const s21_matrix* matrix);
+int s21_matrix_cols(const s21_matrix* matrix);
+int s21_matrix_stride(const s21_matrix* matrix);
+/* Указатель на первый элемент, запись через него видна матрице.
+ * Хеш такой матрицы больше не кешируется, поэтому запись безопасна для
+ * сравнений и кеша результатов; указатель действует до изменения размера */
+double* s21_matrix_data(s21_matrix* matrix);
+
+/* Долгие операции не обращаются к глобальному состоянию вызывающего
+ * и могут выполняться из нескольких потоков одновременно */
+s21_matrix_status s21_matrix_multiply(const s21_matrix* a,
+                                      const s21_matrix* b,
+                                      s21_matrix** result);
+s21_matrix_status s21_matrix_inverse(const s21_matrix* matrix,
+                                     s21_matrix** result);
+s21_matrix_status s21_matrix_determinant(const s21_matrix* matrix,
+                                         double* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,190 @@
+#include "s21_matrix_cache.h"
+
+#include <utility>
+
+S21MatrixCache::S21MatrixCache() : budget_(0), bytes_(0), stats_() {}
+
+S21MatrixCache& S21MatrixCache::Instance() {
+  static S21MatrixCache cache;
+  return cache;
+}
+
+void S21MatrixCache::Enable(std::size_t budget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = budget;
+  Evict();
+}
+
+void S21MatrixCache::Disable() { Enable(0); }
+
+bool S21MatrixCache::IsEnabled() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_ > 0;
+}
+
+void S21MatrixCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  bytes_ = 0;
+}
+
+S21MatrixCache::Stats S21MatrixCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.entries = static_cast<int>(entries_.size());
+  stats.bytes = bytes_;
+  return stats;
+}
+
+void S21MatrixCache::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_ = Stats();
+}
+
+std::shared_ptr<const S21MatrixDecomposition::LU> S21MatrixCache::FindLU(
+    const S21Matrix& key) {
+  Entry entry{};
+  Lookup(key, entry);
+  return entry.lu;
+}
+
+void S21MatrixCache::StoreLU(const S21Matrix& key,
+                             S21MatrixDecomposition::LU lu) {
+  std::size_t bytes = Bytes(lu.lu) + lu.permutation.size() * sizeof(int);
+  auto value =
+      std::make_shared<const S21MatrixDecomposition::LU>(std::move(lu));
+  Store(key, [this, &value, bytes](Entry& entry) {
+    if (entry.lu == nullptr) {
+      entry.lu = value;
+      Resize(entry, entry.bytes + bytes);
+    }
+  });
+}
+
+bool S21MatrixCache::FindDeterminant(const S21Matrix& key, double& det) {
+  Entry entry{};
+  bool found = false;
+  if (Lookup(key, entry)) {
+    found = entry.hasDeterminant;
+    if (found) det = entry.determinant;
+    CountLookup(found);
+  }
+  return found;
+}
+
+void S21MatrixCache::StoreDeterminant(const S21Matrix& key, double det) {
+  Store(key, [this, det](Entry& entry) {
+    entry.hasDeterminant = true;
+    entry.determinant = det;
+    Evict();
+  });
+}
+
+std::shared_ptr<const S21Matrix> S21MatrixCache::FindInverse(
+    const S21Matrix& key) {
+  Entry entry{};
+  if (Lookup(key, entry)) CountLookup(entry.inverse != nullptr);
+  return entry.inverse;
+}
+
+void S21MatrixCache::StoreInverse(const S21Matrix& key,
+                                  const S21Matrix& inverse) {
+  if (!IsEnabled()) return;
+  auto value = std::make_shared<const S21Matrix>(inverse);
+  std::size_t bytes = Bytes(inverse);
+  Store(key, [this, &value, bytes](Entry& entry) {
+    if (entry.inverse == nullptr) {
+      entry.inverse = value;
+      Resize(entry, entry.bytes + bytes);
+    }
+  });
+}
+
+bool S21MatrixCache::Lookup(const S21Matrix& key, Entry& found) {
+  if (!IsEnabled()) return false;
+  std::uint64_t hash = key.GetHash();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(hash);
+    if (it != index_.end()) found = *it->second;
+  }
+  // Совпадение хеша перепроверяется полным сравнением
+  if (found.key != nullptr && !found.key->EqMatrix(key)) found = Entry{};
+  if (found.key != nullptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(hash);
+    // За время сравнения запись могли вытеснить или заменить
+    if (it != index_.end() && it->second->key == found.key) {
+      entries_.splice(entries_.begin(), entries_, it->second);
+    }
+  }
+  return true;
+}
+
+template <typename Update>
+void S21MatrixCache::Store(const S21Matrix& key, Update update) {
+  if (!IsEnabled()) return;
+  std::uint64_t hash = key.GetHash();
+  std::shared_ptr<const S21Matrix> existing;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(hash);
+    if (it != index_.end()) existing = it->second->key;
+  }
+  // Сравнение и копирование ключа тоже выполняются без блокировки
+  std::shared_ptr<const S21Matrix> stored =
+      existing != nullptr && existing->EqMatrix(key)
+          ? existing
+          : std::make_shared<const S21Matrix>(key);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (budget_ == 0) return;
+  auto it = index_.find(hash);
+  if (it != index_.end() && it->second->key != stored) {
+    // Коллизия или параллельная вставка: запись с тем же хешем заменяется
+    bytes_ -= it->second->bytes;
+    entries_.erase(it->second);
+    index_.erase(it);
+    it = index_.end();
+  }
+  if (it == index_.end()) {
+    entries_.push_front({stored, hash, false, 0, nullptr, nullptr,
+                         Bytes(*stored)});
+    index_[hash] = entries_.begin();
+    bytes_ += entries_.front().bytes;
+  } else {
+    entries_.splice(entries_.begin(), entries_, it->second);
+  }
+  update(entries_.front());
+}
+
+void S21MatrixCache::CountLookup(bool hit) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (hit) {
+    stats_.hits++;
+  } else {
+    stats_.misses++;
+  }
+}
+
+void S21MatrixCache::Resize(Entry& entry, std::size_t bytes) {
+  bytes_ += bytes - entry.bytes;
+  entry.bytes = bytes;
+  Evict();
+}
+
+void S21MatrixCache::Evict() {
+  while (bytes_ > budget_ && !entries_.empty()) {
+    Entry& last = entries_.back();
+    bytes_ -= last.bytes;
+    index_.erase(last.hash);
+    entries_.pop_back();
+    stats_.evictions++;
+  }
+}
+
+std::size_t S21MatrixCache::Bytes(const S21Matrix& matrix) {
+  return sizeof(S21Matrix) + static_cast<std::size_t>(matrix.GetRows()) *
+                                 matrix.GetCols() * sizeof(double);
+}
@@ -0,0 +1,82 @@
+#ifndef S21_MATRIX_CACHE_H
+#define S21_MATRIX_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "s21_matrix_decomposition.h"
+#include "s21_matrix_oop.h"
+
+// Кеш LU-разложений, обратных матриц и определителей, ключ - размер и хеш
+// содержимого. Изменение матрицы меняет её хеш, поэтому устаревшие записи
+// больше не находятся и вытесняются по LRU. По умолчанию выключен.
+// Хеширование и сравнение ключей идут вне общей блокировки, а хеш
+// неизменённой матрицы берётся из её кеша без прохода по элементам.
+// В статистике учитывается один поиск на публичную операцию: FindLU
+// используется внутри определителя и обращения и поисков не считает.
+class S21MatrixCache {
+ public:
+  struct Stats {
+    long hits;
+    long misses;
+    long evictions;
+    int entries;
+    std::size_t bytes;
+  };
+
+  static S21MatrixCache& Instance();
+
+  // Бюджет памяти в байтах, 0 выключает кеш
+  void Enable(std::size_t budget);
+  void Disable();
+  bool IsEnabled() const;
+  void Clear();
+  Stats GetStats() const;
+  void ResetStats();
+
+  std::shared_ptr<const S21MatrixDecomposition::LU> FindLU(
+      const S21Matrix& key);
+  void StoreLU(const S21Matrix& key, S21MatrixDecomposition::LU lu);
+  bool FindDeterminant(const S21Matrix& key, double& det);
+  void StoreDeterminant(const S21Matrix& key, double det);
+  std::shared_ptr<const S21Matrix> FindInverse(const S21Matrix& key);
+  void StoreInverse(const S21Matrix& key, const S21Matrix& inverse);
+
+ private:
+  struct Entry {
+    std::shared_ptr<const S21Matrix> key;
+    std::uint64_t hash;
+    bool hasDeterminant;
+    double determinant;
+    std::shared_ptr<const S21MatrixDecomposition::LU> lu;
+    std::shared_ptr<const S21Matrix> inverse;
+    std::size_t bytes;
+  };
+
+  S21MatrixCache();
+
+  mutable std::mutex mutex_;
+  std::size_t budget_;
+  std::size_t bytes_;
+  std::list<Entry> entries_;
+  std::unordered_map<std::uint64_t, std::list<Entry>::iterator> index_;
+  Stats stats_;
+
+  // Копия записи с содержимым key или пустая запись; false, если кеш
+  // выключен
+  bool Lookup(const S21Matrix& key, Entry& found);
+  // Находит или создаёт запись для key и под блокировкой передаёт её в
+  // update
+  template <typename Update>
+  void Store(const S21Matrix& key, Update update);
+  void CountLookup(bool hit);
+  void Resize(Entry& entry, std::size_t bytes);
+  void Evict();
+  static std::size_t Bytes(const S21Matrix& matrix);
+};
+
+#endif
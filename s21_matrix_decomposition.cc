@@ -0,0 +1,622 @@
+#include "s21_matrix_decomposition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "s21_matrix_async.h"
+#include "s21_matrix_exception.h"
+#include "s21_matrix_executor.h"
+
+S21MatrixDecomposition::LU S21MatrixDecomposition::PartialPivotLU(
+    const S21Matrix& a) {
+  S21MatrixException::CheckSquare(a.rows_, a.cols_);
+  int n = a.rows_;
+  S21Matrix lu(a);
+  lu.Detach();
+  std::vector<int> permutation(n);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  int sign = 1;
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (std::abs(lu.matrix_[i][k]) > std::abs(lu.matrix_[pivot][k])) {
+        pivot = i;
+      }
+    }
+    if (pivot != k) {
+      std::swap_ranges(lu.matrix_[k], lu.matrix_[k] + n, lu.matrix_[pivot]);
+      std::swap(permutation[k], permutation[pivot]);
+      sign = -sign;
+    }
+    double diagonal = lu.matrix_[k][k];
+    // Нулевой столбец: матрица вырождена, определитель будет равен нулю
+    if (diagonal == 0) continue;
+    auto eliminate = [&lu, k, n, diagonal](int from, int to) {
+      const double* top = lu.matrix_[k];
+      for (int i = from; i < to; ++i) {
+        double* row = lu.matrix_[i];
+        double factor = row[k] / diagonal;
+        row[k] = factor;
+        for (int j = k + 1; j < n; ++j) row[j] -= factor * top[j];
+      }
+    };
+    long work = static_cast<long>(n - k) * (n - k);
+    if (work >= kParallelWork) {
+      S21MatrixExecutor::Instance().ParallelFor(k + 1, n, eliminate);
+    } else {
+      eliminate(k + 1, n);
+    }
+  }
+  return {std::move(lu), std::move(permutation), sign};
+}
+
+double S21MatrixDecomposition::Determinant(const LU& lu) {
+  double result = lu.sign;
+  for (int i = 0; i < lu.lu.rows_; ++i) result *= lu.lu.matrix_[i][i];
+  return result;
+}
+
+S21Matrix S21MatrixDecomposition::Inverse(const LU& lu,
+                                          S21MatrixProgress* progress) {
+  int n = lu.lu.rows_;
+  double** a = lu.lu.matrix_;
+  // Решаем L * U * X = P сразу для всех столбцов, обходя X по строкам
+  S21Matrix x = S21Matrix::Uninitialized(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      x.matrix_[i][j] = lu.permutation[i] == j ? 1.0 : 0.0;
+    }
+  }
+  if (progress != nullptr) progress->SetTotal(2L * n);
+  bool parallel = static_cast<long>(n) * n >= kParallelWork;
+  auto solveRow = [&x, a, n](int i, bool forward, int from, int to) {
+    double* row = x.matrix_[i];
+    int begin = forward ? 0 : i + 1;
+    int end = forward ? i : n;
+    for (int k = begin; k < end; ++k) {
+      double factor = a[i][k];
+      const double* other = x.matrix_[k];
+      for (int j = from; j < to; ++j) row[j] -= factor * other[j];
+    }
+    if (!forward) {
+      for (int j = from; j < to; ++j) row[j] /= a[i][i];
+    }
+  };
+  for (int step = 0; step < 2 * n; ++step) {
+    if (progress != nullptr) progress->Report(step);
+    bool forward = step < n;
+    int i = forward ? step : 2 * n - 1 - step;
+    if (parallel) {
+      S21MatrixExecutor::Instance().ParallelFor(
+          0, n, [&solveRow, i, forward](int from, int to) {
+            solveRow(i, forward, from, to);
+          });
+    } else {
+      solveRow(i, forward, 0, n);
+    }
+  }
+  if (progress != nullptr) progress->Report(2L * n);
+  return x;
+}
+
+S21MatrixDecomposition::QR S21MatrixDecomposition::HouseholderQR(
+    const S21Matrix& a) {
+  int rows = a.rows_;
+  int cols = a.cols_;
+  int k = std::min(rows, cols);
+  S21Matrix r(a);
+  r.Detach();
+  std::vector<std::vector<double>> reflectors(k, std::vector<double>(rows, 0));
+  std::vector<double> taus(k, 0);
+  std::vector<std::vector<double>> factors;
+
+  for (int panel = 0; panel < k; panel += kPanel) {
+    int end = std::min(k, panel + kPanel);
+    // Внутри панели отражения применяются по одному только к её столбцам
+    for (int j = panel; j < end; ++j) {
+      double norm = 0;
+      for (int i = j; i < rows; ++i) {
+        norm += r.matrix_[i][j] * r.matrix_[i][j];
+      }
+      norm = std::sqrt(norm);
+      if (norm == 0) continue;
+      // Знак выбирается так, чтобы не вычитать близкие числа
+      double alpha = r.matrix_[j][j] >= 0 ? -norm : norm;
+      std::vector<double>& v = reflectors[j];
+      v[j] = r.matrix_[j][j] - alpha;
+      double length = v[j] * v[j];
+      for (int i = j + 1; i < rows; ++i) {
+        v[i] = r.matrix_[i][j];
+        length += v[i] * v[i];
+      }
+      taus[j] = 2.0 / length;
+      ApplyReflector(r, v, taus[j], j, j + 1, end);
+      r.matrix_[j][j] = alpha;
+      for (int i = j + 1; i < rows; ++i) r.matrix_[i][j] = 0;
+    }
+    factors.push_back(TriangularFactor(reflectors, taus, panel, end));
+    ApplyBlock(r, reflectors, factors.back(), panel, end, end, cols, true);
+  }
+
+  // Q = Q_0 * Q_1 * ..., панели накапливаются справа налево. Столбцы левее
+  // панели остаются столбцами единичной матрицы
+  S21Matrix q = S21Matrix::Uninitialized(rows, k);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < k; ++j) q.matrix_[i][j] = i == j ? 1.0 : 0.0;
+  }
+  for (int p = static_cast<int>(factors.size()) - 1; p >= 0; --p) {
+    int panel = p * kPanel;
+    int end = std::min(k, panel + kPanel);
+    ApplyBlock(q, reflectors, factors[p], panel, end, panel, k, false);
+  }
+  r.SetRows(k);
+  return {std::move(q), std::move(r)};
+}
+
+std::vector<double> S21MatrixDecomposition::TriangularFactor(
+    const std::vector<std::vector<double>>& reflectors,
+    const std::vector<double>& taus, int begin, int end) {
+  // Прямое накопление по столбцам, как dlarft из LAPACK:
+  // T[0:i, i] = -tau_i * T[0:i, 0:i] * (V[:, 0:i]^T * v_i)
+  int size = end - begin;
+  int rows = static_cast<int>(reflectors[begin].size());
+  std::vector<double> t(static_cast<std::size_t>(size) * size, 0);
+  std::vector<double> z(size, 0);
+  for (int i = 0; i < size; ++i) {
+    const std::vector<double>& vi = reflectors[begin + i];
+    double tau = taus[begin + i];
+    for (int p = 0; p < i; ++p) {
+      const std::vector<double>& vp = reflectors[begin + p];
+      double dot = 0;
+      for (int row = begin + i; row < rows; ++row) dot += vp[row] * vi[row];
+      z[p] = -tau * dot;
+    }
+    for (int p = 0; p < i; ++p) {
+      double sum = 0;
+      for (int c = p; c < i; ++c) sum += t[p * size + c] * z[c];
+      t[p * size + i] = sum;
+    }
+    t[i * size + i] = tau;
+  }
+  return t;
+}
+
+void S21MatrixDecomposition::ApplyBlock(
+    S21Matrix& target, const std::vector<std::vector<double>>& reflectors,
+    const std::vector<double>& t, int begin, int end, int colBegin,
+    int colEnd, bool transposed) {
+  int rows = target.rows_;
+  int size = end - begin;
+  // Обход по строкам, как в ApplyReflector: W = V^T * A, W = op(T) * W,
+  // A -= V * W. Элементы V выше диагонали нулевые
+  auto update = [&](int from, int to) {
+    int width = to - from;
+    std::vector<double> w(static_cast<std::size_t>(size) * width, 0);
+    for (int i = begin; i < rows; ++i) {
+      const double* line = target.matrix_[i] + from;
+      int last = std::min(size, i - begin + 1);
+      for (int p = 0; p < last; ++p) {
+        double v = reflectors[begin + p][i];
+        double* wp = w.data() + p * width;
+        for (int c = 0; c < width; ++c) wp[c] += v * line[c];
+      }
+    }
+    // Треугольный множитель на месте: для T^T новые строки зависят от
+    // предыдущих, для T - от последующих
+    for (int step = 0; step < size; ++step) {
+      int p = transposed ? size - 1 - step : step;
+      double* wp = w.data() + p * width;
+      double diagonal = t[p * size + p];
+      for (int c = 0; c < width; ++c) wp[c] *= diagonal;
+      int first = transposed ? 0 : p + 1;
+      int last = transposed ? p : size;
+      for (int q = first; q < last; ++q) {
+        double factor = transposed ? t[q * size + p] : t[p * size + q];
+        const double* wq = w.data() + q * width;
+        for (int c = 0; c < width; ++c) wp[c] += factor * wq[c];
+      }
+    }
+    for (int i = begin; i < rows; ++i) {
+      double* line = target.matrix_[i] + from;
+      int last = std::min(size, i - begin + 1);
+      for (int p = 0; p < last; ++p) {
+        double v = reflectors[begin + p][i];
+        const double* wp = w.data() + p * width;
+        for (int c = 0; c < width; ++c) line[c] -= v * wp[c];
+      }
+    }
+  };
+  long work = static_cast<long>(rows - begin) * size * (colEnd - colBegin);
+  if (work >= kParallelWork) {
+    S21MatrixExecutor::Instance().ParallelFor(colBegin, colEnd, update);
+  } else if (colBegin < colEnd) {
+    update(colBegin, colEnd);
+  }
+}
+
+void S21MatrixDecomposition::ApplyReflector(S21Matrix& target,
+                                            const std::vector<double>& v,
+                                            double tau, int row, int colBegin,
+                                            int colEnd) {
+  int rows = target.rows_;
+  // Обход по строкам: w = v^T * A, затем A -= tau * v * w
+  auto update = [&target, &v, tau, row, rows](int from, int to) {
+    std::vector<double> w(to - from, 0);
+    for (int i = row; i < rows; ++i) {
+      const double* line = target.matrix_[i] + from;
+      for (int c = 0; c < to - from; ++c) w[c] += v[i] * line[c];
+    }
+    for (int i = row; i < rows; ++i) {
+      double* line = target.matrix_[i] + from;
+      double f = tau * v[i];
+      for (int c = 0; c < to - from; ++c) line[c] -= f * w[c];
+    }
+  };
+  long work = static_cast<long>(rows - row) * (colEnd - colBegin);
+  if (work >= kParallelWork) {
+    S21MatrixExecutor::Instance().ParallelFor(colBegin, colEnd, update);
+  } else if (colBegin < colEnd) {
+    update(colBegin, colEnd);
+  }
+}
+
+S21MatrixDecomposition::Eigen S21MatrixDecomposition::SymmetricEigen(
+    const S21Matrix& a) {
+  S21MatrixException::CheckSymmetric(a);
+  int n = a.rows_;
+  S21Matrix v(a);
+  v.Detach();
+  std::vector<double> d(n, 0);
+  std::vector<double> e(n, 0);
+  Tridiagonalize(v, d, e);
+  // Вращения QL комбинируют столбцы V, поэтому векторы хранятся строками
+  S21Matrix vt = v.Transpose();
+  TridiagonalQL(vt, d, e);
+  S21Matrix values = S21Matrix::Uninitialized(n, 1);
+  for (int i = 0; i < n; ++i) values.matrix_[i][0] = d[i];
+  return {values, vt.Transpose()};
+}
+
+void S21MatrixDecomposition::Tridiagonalize(S21Matrix& v,
+                                            std::vector<double>& d,
+                                            std::vector<double>& e) {
+  // Приведение Хаусхолдера к трёхдиагональному виду (tred2 из EISPACK).
+  // Используется только нижний треугольник, все циклы идут по строкам
+  int n = v.rows_;
+  double** z = v.matrix_;
+  auto forRange = [](int from, int to, long work,
+                    const std::function<void(int, int)>& body) {
+    if (work >= kParallelWork) {
+      S21MatrixExecutor::Instance().ParallelFor(from, to, body);
+    } else if (from < to) {
+      body(from, to);
+    }
+  };
+  for (int j = 0; j < n; ++j) d[j] = z[n - 1][j];
+  for (int i = n - 1; i > 0; --i) {
+    double scale = 0;
+    double h = 0;
+    for (int k = 0; k < i; ++k) scale += std::abs(d[k]);
+    if (scale == 0) {
+      e[i] = d[i - 1];
+      for (int j = 0; j < i; ++j) {
+        d[j] = z[i - 1][j];
+        z[i][j] = 0;
+        z[j][i] = 0;
+      }
+    } else {
+      for (int k = 0; k < i; ++k) {
+        d[k] /= scale;
+        h += d[k] * d[k];
+      }
+      double f = d[i - 1];
+      double g = f > 0 ? -std::sqrt(h) : std::sqrt(h);
+      e[i] = scale * g;
+      h -= f * g;
+      d[i - 1] = f - g;
+      // e = A * d по нижнему треугольнику
+      for (int j = 0; j < i; ++j) {
+        z[j][i] = d[j];
+        e[j] = 0;
+      }
+      for (int k = 0; k < i; ++k) {
+        const double* row = z[k];
+        double dk = d[k];
+        double sum = 0;
+        for (int j = 0; j < k; ++j) {
+          sum += row[j] * d[j];
+          e[j] += row[j] * dk;
+        }
+        e[k] += sum + row[k] * dk;
+      }
+      f = 0;
+      for (int j = 0; j < i; ++j) {
+        e[j] /= h;
+        f += e[j] * d[j];
+      }
+      double hh = f / (h + h);
+      for (int j = 0; j < i; ++j) e[j] -= hh * d[j];
+      // Симметричное обновление ранга 2: A -= d * e^T + e * d^T
+      forRange(0, i, static_cast<long>(i) * i / 2, [z, &d, &e](int from,
+                                                              int to) {
+        for (int k = from; k < to; ++k) {
+          double* row = z[k];
+          double dk = d[k];
+          double ek = e[k];
+          for (int j = 0; j <= k; ++j) row[j] -= d[j] * ek + e[j] * dk;
+        }
+      });
+      for (int j = 0; j < i; ++j) {
+        d[j] = z[i - 1][j];
+        z[i][j] = 0;
+      }
+    }
+    d[i] = h;
+  }
+  // Накопление преобразований: Z -= (1 / h) * u * (u^T * Z), где u -
+  // столбец i + 1, как в ApplyReflector
+  for (int i = 0; i < n - 1; ++i) {
+    z[n - 1][i] = z[i][i];
+    z[i][i] = 1;
+    double h = d[i + 1];
+    if (h != 0) {
+      int size = i + 1;
+      forRange(0, size, static_cast<long>(size) * size, [z, size, h](int from,
+                                                                     int to) {
+        std::vector<double> w(to - from, 0);
+        for (int k = 0; k < size; ++k) {
+          const double* line = z[k] + from;
+          double u = z[k][size];
+          for (int c = 0; c < to - from; ++c) w[c] += u * line[c];
+        }
+        for (int k = 0; k < size; ++k) {
+          double* line = z[k] + from;
+          double f = z[k][size] / h;
+          for (int c = 0; c < to - from; ++c) line[c] -= f * w[c];
+        }
+      });
+    }
+    for (int k = 0; k <= i; ++k) z[k][i + 1] = 0;
+  }
+  for (int j = 0; j < n; ++j) {
+    d[j] = z[n - 1][j];
+    z[n - 1][j] = 0;
+  }
+  z[n - 1][n - 1] = 1;
+  e[0] = 0;
+}
+
+void S21MatrixDecomposition::TridiagonalQL(S21Matrix& vt,
+                                           std::vector<double>& d,
+                                           std::vector<double>& e) {
+  // Неявный QL-алгоритм со сдвигами (tql2 из EISPACK). Вращения прохода
+  // запоминаются и применяются к строкам vt после него, части строк
+  // обрабатываются параллельно
+  int n = vt.rows_;
+  for (int i = 1; i < n; ++i) e[i - 1] = e[i];
+  e[n - 1] = 0;
+  double f = 0;
+  double tst1 = 0;
+  const double eps = std::ldexp(1.0, -52);
+  std::vector<double> cosines(n, 0);
+  std::vector<double> sines(n, 0);
+  long sweeps = 0;
+  for (int l = 0; l < n; ++l) {
+    tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+    int m = l;
+    while (m < n && std::abs(e[m]) > eps * tst1) ++m;
+    if (m > l) {
+      do {
+        // NaN и бесконечности не дают процессу сойтись
+        S21MatrixException::CheckConverged(++sweeps <= 30L * n);
+        double g = d[l];
+        double p = (d[l + 1] - g) / (2.0 * e[l]);
+        double r = std::hypot(p, 1.0);
+        if (p < 0) r = -r;
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        double dl1 = d[l + 1];
+        double h = g - d[l];
+        for (int i = l + 2; i < n; ++i) d[i] -= h;
+        f += h;
+        p = d[m];
+        double c = 1;
+        double c2 = c;
+        double c3 = c;
+        double el1 = e[l + 1];
+        double s = 0;
+        double s2 = 0;
+        for (int i = m - 1; i >= l; --i) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = std::hypot(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+          cosines[i] = c;
+          sines[i] = s;
+        }
+        auto rotate = [&vt, &cosines, &sines, l, m](int from, int to) {
+          for (int i = m - 1; i >= l; --i) {
+            double* zi = vt.matrix_[i] + from;
+            double* zn = vt.matrix_[i + 1] + from;
+            double ci = cosines[i];
+            double si = sines[i];
+            for (int k = 0; k < to - from; ++k) {
+              double x = zn[k];
+              zn[k] = si * zi[k] + ci * x;
+              zi[k] = ci * zi[k] - si * x;
+            }
+          }
+        };
+        if (static_cast<long>(m - l) * n >= kParallelWork) {
+          S21MatrixExecutor::Instance().ParallelFor(0, n, rotate);
+        } else {
+          rotate(0, n);
+        }
+        p = -s * s2 * c3 * el1 * e[l] / dl1;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (std::abs(e[l]) > eps * tst1);
+    }
+    d[l] += f;
+    e[l] = 0;
+  }
+  // Сортировка по возрастанию вместе с векторами
+  for (int i = 0; i < n - 1; ++i) {
+    int k = i;
+    for (int j = i + 1; j < n; ++j) {
+      if (d[j] < d[k]) k = j;
+    }
+    if (k != i) {
+      std::swap(d[i], d[k]);
+      std::swap_ranges(vt.matrix_[i], vt.matrix_[i] + n, vt.matrix_[k]);
+    }
+  }
+}
+
+S21MatrixDecomposition::SVD S21MatrixDecomposition::JacobiSVD(
+    const S21Matrix& a) {
+  if (a.rows_ >= a.cols_) return JacobiRows(a.Transpose());
+  // Для широкой матрицы раскладываем A^T и меняем U и V местами
+  SVD transposed = JacobiRows(a);
+  return {transposed.v, transposed.sigma, transposed.u};
+}
+
+S21MatrixDecomposition::SVD S21MatrixDecomposition::JacobiRows(S21Matrix w) {
+  // Копия может делить блок с исходной матрицей в режиме COW
+  w.Detach();
+  int n = w.rows_;
+  int m = w.cols_;
+  S21Matrix vt = S21Matrix::Identity(n);
+
+  // Круговой турнир: в каждом раунде пары не пересекаются и могут
+  // вращаться параллельно
+  int players = n + n % 2;
+  std::vector<int> order(players);
+  std::iota(order.begin(), order.end(), 0);
+  // Скалярное произведение длины m точно лишь до m ulp
+  const double eps = std::numeric_limits<double>::epsilon() * std::max(m, 2);
+  bool parallel = static_cast<long>(n) * m >= kParallelWork;
+  bool converged = false;
+  for (int sweep = 0; !converged && sweep < kSweeps; ++sweep) {
+    std::atomic<bool> rotated(false);
+    for (int round = 0; round < players - 1; ++round) {
+      auto rotate = [&](int from, int to) {
+        for (int pair = from; pair < to; ++pair) {
+          int p = std::min(order[pair], order[players - 1 - pair]);
+          int q = std::max(order[pair], order[players - 1 - pair]);
+          if (q >= n) continue;
+          double* wp = w.matrix_[p];
+          double* wq = w.matrix_[q];
+          double alpha = 0;
+          double beta = 0;
+          double gamma = 0;
+          for (int k = 0; k < m; ++k) {
+            alpha += wp[k] * wp[k];
+            beta += wq[k] * wq[k];
+            gamma += wp[k] * wq[k];
+          }
+          if (std::abs(gamma) <= eps * std::sqrt(alpha * beta)) continue;
+          rotated = true;
+          double zeta = (beta - alpha) / (2 * gamma);
+          double t = (zeta >= 0 ? 1.0 : -1.0) /
+                     (std::abs(zeta) + std::sqrt(1 + zeta * zeta));
+          double c = 1 / std::sqrt(1 + t * t);
+          double s = c * t;
+          for (int k = 0; k < m; ++k) {
+            double x = wp[k];
+            wp[k] = c * x - s * wq[k];
+            wq[k] = s * x + c * wq[k];
+          }
+          double* vp = vt.matrix_[p];
+          double* vq = vt.matrix_[q];
+          for (int k = 0; k < n; ++k) {
+            double x = vp[k];
+            vp[k] = c * x - s * vq[k];
+            vq[k] = s * x + c * vq[k];
+          }
+        }
+      };
+      if (parallel) {
+        S21MatrixExecutor::Instance().ParallelFor(0, players / 2, rotate);
+      } else {
+        rotate(0, players / 2);
+      }
+      std::rotate(order.begin() + 1, order.end() - 1, order.end());
+    }
+    converged = !rotated;
+  }
+  // NaN и бесконечности не дают вращениям остановиться
+  S21MatrixException::CheckConverged(converged);
+
+  std::vector<double> norms(n, 0);
+  for (int i = 0; i < n; ++i) {
+    for (int k = 0; k < m; ++k) norms[i] += w.matrix_[i][k] * w.matrix_[i][k];
+    norms[i] = std::sqrt(norms[i]);
+  }
+  std::vector<int> index(n);
+  std::iota(index.begin(), index.end(), 0);
+  std::stable_sort(index.begin(), index.end(),
+                   [&norms](int x, int y) { return norms[x] > norms[y]; });
+
+  S21Matrix u = S21Matrix::Uninitialized(m, n);
+  S21Matrix sigma = S21Matrix::Uninitialized(n, 1);
+  S21Matrix v = S21Matrix::Uninitialized(n, n);
+  // Столбцы W с нормой на уровне округления не задают направления
+  double threshold = n > 0 ? norms[index[0]] * eps * n : 0;
+  int rank = 0;
+  for (int j = 0; j < n; ++j) {
+    int source = index[j];
+    double norm = norms[source];
+    sigma.matrix_[j][0] = norm;
+    if (norm > threshold) rank = j + 1;
+    for (int k = 0; k < m; ++k) {
+      u.matrix_[k][j] = norm > threshold ? w.matrix_[source][k] / norm : 0.0;
+    }
+    for (int k = 0; k < n; ++k) v.matrix_[k][j] = vt.matrix_[source][k];
+  }
+  CompleteBasis(u, rank);
+  return {std::move(u), std::move(sigma), std::move(v)};
+}
+
+void S21MatrixDecomposition::CompleteBasis(S21Matrix& u, int first) {
+  // Грам-Шмидт с повторной ортогонализацией над единичными векторами:
+  // берётся первый, у которого после проекции остаётся заметная норма,
+  // иначе - лучший из всех
+  int m = u.rows_;
+  std::vector<double> x(m);
+  std::vector<double> best(m);
+  for (int j = first; j < u.cols_; ++j) {
+    double bestLength = -1;
+    for (int candidate = 0; candidate < m && bestLength < 0.5; ++candidate) {
+      std::fill(x.begin(), x.end(), 0.0);
+      x[candidate] = 1;
+      for (int pass = 0; pass < 2; ++pass) {
+        for (int c = 0; c < j; ++c) {
+          double dot = 0;
+          for (int k = 0; k < m; ++k) dot += u.matrix_[k][c] * x[k];
+          for (int k = 0; k < m; ++k) x[k] -= dot * u.matrix_[k][c];
+        }
+      }
+      double length = 0;
+      for (int k = 0; k < m; ++k) length += x[k] * x[k];
+      length = std::sqrt(length);
+      if (length > bestLength) {
+        bestLength = length;
+        best.swap(x);
+      }
+    }
+    for (int k = 0; k < m; ++k) u.matrix_[k][j] = best[k] / bestLength;
+  }
+}
@@ -0,0 +1,86 @@
+#ifndef S21_MATRIX_DECOMPOSITION_H
+#define S21_MATRIX_DECOMPOSITION_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Разложения, работающие напрямую с хранилищем S21Matrix.
+// Для больших матриц обновления распределяются по S21MatrixExecutor.
+class S21MatrixDecomposition {
+ public:
+  // P * A = L * U, L с единичной диагональю хранится под диагональю lu,
+  // permutation[i] - исходный номер i-й строки
+  struct LU {
+    S21Matrix lu;
+    std::vector<int> permutation;
+    int sign;
+  };
+
+  // A = Q * R, Q - m x k с ортонормированными столбцами, R - k x n,
+  // k = min(m, n)
+  struct QR {
+    S21Matrix q;
+    S21Matrix r;
+  };
+
+  // A = V * diag(values) * V^T, собственные значения n x 1 по возрастанию,
+  // собственные векторы - столбцы vectors
+  struct Eigen {
+    S21Matrix values;
+    S21Matrix vectors;
+  };
+
+  // A = U * diag(sigma) * V^T, сингулярные числа k x 1 по убыванию
+  struct SVD {
+    S21Matrix u;
+    S21Matrix sigma;
+    S21Matrix v;
+  };
+
+  static LU PartialPivotLU(const S21Matrix& a);
+  static double Determinant(const LU& lu);
+  static S21Matrix Inverse(const LU& lu, S21MatrixProgress* progress);
+  // Блочный QR: панели по kPanel столбцов, остальные столбцы обновляются
+  // одним проходом в форме I - V * T * V^T
+  static QR HouseholderQR(const S21Matrix& a);
+  // Допускает асимметрию в пределах округления. Приведение к
+  // трёхдиагональному виду не блочное, но идёт по строкам
+  static Eigen SymmetricEigen(const S21Matrix& a);
+  // Бросает std::runtime_error, если вращения не сошлись за kSweeps
+  // проходов. Для вырожденной матрицы U дополняется до ортонормированной
+  static SVD JacobiSVD(const S21Matrix& a);
+
+ private:
+  // Начиная с такого объёма работы обновления выполняются параллельно
+  static constexpr long kParallelWork = 1L << 16;
+  // Ширина панели блочного QR
+  static constexpr int kPanel = 32;
+  static constexpr int kSweeps = 60;
+
+  static void ApplyReflector(S21Matrix& target, const std::vector<double>& v,
+                             double tau, int row, int colBegin, int colEnd);
+  // Треугольный множитель T панели: H_begin * ... * H_{end-1} =
+  // I - V * T * V^T, T хранится по строкам
+  static std::vector<double> TriangularFactor(
+      const std::vector<std::vector<double>>& reflectors,
+      const std::vector<double>& taus, int begin, int end);
+  // A = (I - V * op(T) * V^T) * A для столбцов [colBegin, colEnd), где
+  // op(T) = T^T при transposed
+  static void ApplyBlock(S21Matrix& target,
+                         const std::vector<std::vector<double>>& reflectors,
+                         const std::vector<double>& t, int begin, int end,
+                         int colBegin, int colEnd, bool transposed);
+  static void Tridiagonalize(S21Matrix& v, std::vector<double>& d,
+                             std::vector<double>& e);
+  // Собственные векторы накапливаются в строках vt
+  static void TridiagonalQL(S21Matrix& vt, std::vector<double>& d,
+                            std::vector<double>& e);
+  // Одностороннее вращение Якоби над строками w (столбцами исходной матрицы)
+  static SVD JacobiRows(S21Matrix w);
+  // Заменяет столбцы u начиная с first ортонормированными векторами,
+  // ортогональными предыдущим столбцам
+  static void CompleteBasis(S21Matrix& u, int first);
+};
+
+#endif
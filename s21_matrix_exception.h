@@ -18,14 +18,30 @@ class S21MatrixException {
     }
   }
 
+  static void CheckDimensions(int aRows, int aCols, int bRows, int bCols) {
+    if (aRows != bRows || aCols != bCols) {
+      throw std::invalid_argument("Matrix sizes do not match");
+    }
+  }
+
   static void CheckMultiplication(const S21Matrix& a, const S21Matrix& b) {
-    if (a.GetCols() != b.GetRows()) {
+    CheckMultiplication(a.GetCols(), b.GetRows());
+  }
+
+  static void CheckMultiplication(int aCols, int bRows) {
+    if (aCols != bRows) {
       throw std::invalid_argument(
           "Number of columns of the first matrix must equal the number of rows "
           "of the second matrix for multiplication.");
     }
   }
 
+  static void CheckChain(int count) {
+    if (count <= 0) {
+      throw std::invalid_argument("Matrix chain must not be empty.");
+    }
+  }
+
   static void CheckSquare(int rows, int cols) {
     if (rows != cols) {
       throw std::invalid_argument(
@@ -33,12 +49,76 @@ class S21MatrixException {
     }
   }
 
+  static void CheckSymmetric(const S21Matrix& a) {
+    // Вычисленные матрицы симметричны лишь с точностью до округления
+    if (a.GetRows() != a.GetCols() ||
+        !a.EqMatrix(a.Transpose(), 1e-12, 1e-10)) {
+      throw std::invalid_argument("Matrix must be symmetric.");
+    }
+  }
+
   static void CheckSingular(double det) {
     if (std::abs(det) < 1e-6) {
       throw std::runtime_error("Matrix is singular, inverse does not exist.");
     }
   }
 
+  static void CheckCondition(double condition) {
+    if (!(condition >= 1)) {
+      throw std::invalid_argument("Condition number must be at least one.");
+    }
+  }
+
+  static void CheckBandwidth(int lower, int upper) {
+    if (lower < 0 || upper < 0) {
+      throw std::invalid_argument("Bandwidth must not be negative.");
+    }
+  }
+
+  static void CheckPivot(double pivot) {
+    if (pivot == 0) {
+      throw std::runtime_error("Matrix is singular, system has no solution.");
+    }
+  }
+
+  static void CheckInBand(bool inBand) {
+    if (!inBand) {
+      throw std::out_of_range("Index is outside the matrix band");
+    }
+  }
+
+  static void CheckSameGraph(bool same) {
+    if (!same) {
+      throw std::invalid_argument(
+          "Expressions must belong to the same matrix graph.");
+    }
+  }
+
+  static void CheckConverged(bool converged) {
+    if (!converged) {
+      throw std::runtime_error("Iterative method did not converge.");
+    }
+  }
+
+  static void CheckUlps(long maxUlps) {
+    if (maxUlps < 0) {
+      throw std::invalid_argument("ULP tolerance must not be negative.");
+    }
+  }
+
+  static void CheckCancelled(bool cancelled) {
+    if (cancelled) {
+      throw std::runtime_error("Operation was cancelled.");
+    }
+  }
+
+  static void CheckStride(const double* data, int cols, int stride) {
+    if (data == nullptr || stride < cols) {
+      throw std::invalid_argument(
+          "Buffer must be non-null with a row stride of at least cols");
+    }
+  }
+
   static void CheckRows(int rows) {
     if (rows <= 0) {
       throw std::invalid_argument("Number of rows must be greater than zero");
@@ -0,0 +1,170 @@
+#include "s21_matrix_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include "s21_matrix_numa.h"
+
+// Номер потока пула, выполняющего текущую задачу, или -1
+static thread_local int currentWorker = -1;
+
+S21MatrixExecutor::S21MatrixExecutor(int threads) : stop_(false) {
+  if (threads < 1) threads = 1;
+  pinned_.resize(threads);
+  busy_.resize(threads, false);
+  for (int i = 0; i < threads; ++i) {
+    workers_.emplace_back(&S21MatrixExecutor::WorkerLoop, this, i);
+  }
+}
+
+S21MatrixExecutor::~S21MatrixExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+}
+
+S21MatrixExecutor& S21MatrixExecutor::Instance() {
+  static S21MatrixExecutor executor(
+      static_cast<int>(std::thread::hardware_concurrency()));
+  return executor;
+}
+
+int S21MatrixExecutor::GetThreadCount() const {
+  return static_cast<int>(workers_.size());
+}
+
+void S21MatrixExecutor::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+void S21MatrixExecutor::ParallelFor(
+    int begin, int end, const std::function<void(int, int)>& body) {
+  int count = end - begin;
+  if (count <= 0) return;
+  int chunks = std::min(count, 4 * (GetThreadCount() + 1));
+  if (chunks == 1) {
+    body(begin, end);
+    return;
+  }
+
+  struct Shared {
+    std::atomic<int> next{0};
+    int finished = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  auto shared = std::make_shared<Shared>();
+  const std::function<void(int, int)>* function = &body;
+  auto work = [shared, function, begin, count, chunks] {
+    for (int chunk = shared->next++; chunk < chunks;
+         chunk = shared->next++) {
+      int from = begin + static_cast<int>(1LL * count * chunk / chunks);
+      int to = begin + static_cast<int>(1LL * count * (chunk + 1) / chunks);
+      std::exception_ptr error;
+      try {
+        (*function)(from, to);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(shared->mutex);
+      if (error && !shared->error) shared->error = error;
+      if (++shared->finished == chunks) shared->done.notify_all();
+    }
+  };
+  // Опоздавшие помощники не находят частей и не трогают body
+  for (int i = 0; i < GetThreadCount(); ++i) Submit(work);
+  work();
+  std::unique_lock<std::mutex> lock(shared->mutex);
+  shared->done.wait(lock, [&shared, chunks] {
+    return shared->finished == chunks;
+  });
+  if (shared->error) std::rethrow_exception(shared->error);
+}
+
+void S21MatrixExecutor::ParallelForStatic(
+    int begin, int end, const std::function<void(int, int)>& body) {
+  int count = end - begin;
+  int parts = std::min(count, GetThreadCount());
+  // Поток пула, ждущий свою же очередь, заблокировал бы её
+  if (currentWorker >= 0 || parts <= 1) {
+    ParallelFor(begin, end, body);
+    return;
+  }
+
+  struct Shared {
+    int finished = 0;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  auto shared = std::make_shared<Shared>();
+  const std::function<void(int, int)>* function = &body;
+  auto run = [shared, function, begin, count, parts](int part) {
+    int from = begin + static_cast<int>(1LL * count * part / parts);
+    int to = begin + static_cast<int>(1LL * count * (part + 1) / parts);
+    std::exception_ptr error;
+    try {
+      (*function)(from, to);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    if (error && !shared->error) shared->error = error;
+    if (++shared->finished == parts) shared->done.notify_all();
+  };
+  // Свободный поток первой возьмёт свою очередь, а занятый долгой задачей
+  // задержал бы весь вызов, поэтому его часть остаётся вызывающему
+  std::vector<int> own;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int part = 0; part < parts; ++part) {
+      if (busy_[part]) {
+        own.push_back(part);
+      } else {
+        pinned_[part].push_back([run, part] { run(part); });
+      }
+    }
+  }
+  condition_.notify_all();
+  for (int part : own) run(part);
+  std::unique_lock<std::mutex> lock(shared->mutex);
+  shared->done.wait(lock, [&shared, parts] {
+    return shared->finished == parts;
+  });
+  if (shared->error) std::rethrow_exception(shared->error);
+}
+
+void S21MatrixExecutor::WorkerLoop(int index) {
+  S21MatrixNuma::PinThread(index);
+  currentWorker = index;
+  std::deque<std::function<void()>>& pinned = pinned_[index];
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      busy_[index] = false;
+      condition_.wait(lock, [this, &pinned] {
+        return stop_ || !tasks_.empty() || !pinned.empty();
+      });
+      // Перед остановкой дорабатываем оставшиеся задачи
+      std::deque<std::function<void()>>& queue =
+          !pinned.empty() ? pinned : tasks_;
+      if (queue.empty()) return;
+      busy_[index] = &queue == &tasks_;
+      task = std::move(queue.front());
+      queue.pop_front();
+    }
+    task();
+  }
+}
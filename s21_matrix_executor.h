@@ -0,0 +1,52 @@
+#ifndef S21_MATRIX_EXECUTOR_H
+#define S21_MATRIX_EXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Общий пул потоков для асинхронных операций над матрицами. На машине
+// с несколькими узлами NUMA рабочие потоки привязаны к узлам по кругу.
+class S21MatrixExecutor {
+ public:
+  explicit S21MatrixExecutor(int threads);
+  S21MatrixExecutor(const S21MatrixExecutor& other) = delete;
+  S21MatrixExecutor& operator=(const S21MatrixExecutor& other) = delete;
+  ~S21MatrixExecutor();
+
+  static S21MatrixExecutor& Instance();
+
+  int GetThreadCount() const;
+  void Submit(std::function<void()> task);
+  // Делит [begin, end) на части и выполняет body(from, to) параллельно.
+  // Вызывающий поток тоже обрабатывает части, поэтому вызов из задачи
+  // этого же пула не приводит к взаимной блокировке.
+  void ParallelFor(int begin, int end,
+                   const std::function<void(int, int)>& body);
+  // Делит [begin, end) на равные части по числу потоков, i-я часть по
+  // возможности выполняется i-м потоком. Страницы, впервые записанные так,
+  // лежат на узле NUMA потока, который обработает ту же часть в следующий
+  // раз. Части потоков, занятых задачами из Submit, выполняет вызывающий
+  // поток, чтобы не ждать их. Из задачи этого же пула выполняется как
+  // ParallelFor.
+  void ParallelForStatic(int begin, int end,
+                         const std::function<void(int, int)>& body);
+
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  // Задачи, адресованные конкретному потоку
+  std::vector<std::deque<std::function<void()>>> pinned_;
+  // Поток выполняет задачу из общей очереди и может быть занят долго
+  std::vector<bool> busy_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_;
+
+  void WorkerLoop(int index);
+};
+
+#endif
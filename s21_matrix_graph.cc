@@ -0,0 +1,261 @@
+#include "s21_matrix_graph.h"
+
+#include <cstring>
+#include <utility>
+
+#include "s21_matrix_exception.h"
+
+S21MatrixExpr::S21MatrixExpr(S21MatrixGraph* graph, int id)
+    : graph_(graph), id_(id) {}
+
+int S21MatrixExpr::GetRows() const { return graph_->nodes_[id_].rows; }
+int S21MatrixExpr::GetCols() const { return graph_->nodes_[id_].cols; }
+
+S21MatrixExpr S21MatrixExpr::operator+(const S21MatrixExpr& other) const {
+  S21MatrixException::CheckSameGraph(graph_ == other.graph_);
+  return S21MatrixExpr(
+      graph_, graph_->Make(S21MatrixGraph::Kind::kSum, id_, other.id_, 0));
+}
+
+S21MatrixExpr S21MatrixExpr::operator-(const S21MatrixExpr& other) const {
+  S21MatrixException::CheckSameGraph(graph_ == other.graph_);
+  return S21MatrixExpr(
+      graph_, graph_->Make(S21MatrixGraph::Kind::kSub, id_, other.id_, 0));
+}
+
+S21MatrixExpr S21MatrixExpr::operator*(const S21MatrixExpr& other) const {
+  S21MatrixException::CheckSameGraph(graph_ == other.graph_);
+  return S21MatrixExpr(
+      graph_, graph_->Make(S21MatrixGraph::Kind::kMul, id_, other.id_, 0));
+}
+
+S21MatrixExpr S21MatrixExpr::operator*(double num) const {
+  return S21MatrixExpr(
+      graph_, graph_->Make(S21MatrixGraph::Kind::kScale, id_, -1, num));
+}
+
+S21MatrixExpr S21MatrixExpr::Transpose() const {
+  return S21MatrixExpr(
+      graph_, graph_->Make(S21MatrixGraph::Kind::kTranspose, id_, -1, 0));
+}
+
+S21Matrix S21MatrixExpr::Evaluate() const { return graph_->Evaluate(*this); }
+
+S21MatrixGraph::S21MatrixGraph() : stats_() {}
+
+S21MatrixExpr S21MatrixGraph::Input(const S21Matrix& matrix) {
+  auto it = inputs_.find(&matrix);
+  if (it == inputs_.end()) {
+    nodes_.push_back({Kind::kInput, -1, -1, 0, matrix.GetRows(),
+                      matrix.GetCols(), &matrix});
+    it = inputs_.emplace(&matrix, static_cast<int>(nodes_.size()) - 1).first;
+  }
+  return S21MatrixExpr(this, it->second);
+}
+
+int S21MatrixGraph::GetNodeCount() const {
+  return static_cast<int>(nodes_.size());
+}
+
+S21MatrixGraph::Stats S21MatrixGraph::GetStats() const { return stats_; }
+
+S21Matrix S21MatrixGraph::Evaluate(const S21MatrixExpr& expr) {
+  // Номера узлов имеют смысл только в графе, который их создал
+  S21MatrixException::CheckSameGraph(expr.graph_ == this);
+  stats_ = Stats();
+  simplified_.clear();
+  values_.clear();
+  uses_.assign(nodes_.size(), 0);
+  CountUses(expr.id_);
+  // Входы могли изменить размер после записи в граф
+  for (const auto& [matrix, id] : inputs_) {
+    if (uses_[id] > 0) {
+      S21MatrixException::CheckDimensions(nodes_[id].rows, nodes_[id].cols,
+                                          matrix->GetRows(),
+                                          matrix->GetCols());
+    }
+  }
+  int root = Simplify(expr.id_);
+  // После перестановок число использований узлов меняется
+  uses_.assign(nodes_.size(), 0);
+  CountUses(root);
+  S21Matrix result = Compute(root);
+  values_.clear();
+  return result;
+}
+
+int S21MatrixGraph::Make(Kind kind, int lhs, int rhs, double scalar) {
+  // Сложение коммутативно, приводим аргументы к одному порядку
+  if (kind == Kind::kSum && rhs < lhs) std::swap(lhs, rhs);
+  std::uint64_t bits;
+  std::memcpy(&bits, &scalar, sizeof(bits));
+  auto key = std::make_tuple(static_cast<int>(kind), lhs, rhs, bits);
+  auto it = known_.find(key);
+  if (it != known_.end()) return it->second;
+
+  const Node& left = nodes_[lhs];
+  Node node = {kind, lhs, rhs, scalar, left.rows, left.cols, nullptr};
+  if (kind == Kind::kSum || kind == Kind::kSub) {
+    S21MatrixException::CheckDimensions(left.rows, left.cols, nodes_[rhs].rows,
+                                        nodes_[rhs].cols);
+  } else if (kind == Kind::kMul) {
+    S21MatrixException::CheckMultiplication(left.cols, nodes_[rhs].rows);
+    node.cols = nodes_[rhs].cols;
+  } else if (kind == Kind::kTranspose) {
+    node.rows = left.cols;
+    node.cols = left.rows;
+  }
+  nodes_.push_back(node);
+  int id = static_cast<int>(nodes_.size()) - 1;
+  known_.emplace(key, id);
+  return id;
+}
+
+void S21MatrixGraph::CountUses(int id) {
+  if (uses_[id]++ > 0) return;
+  Node node = nodes_[id];
+  if (node.kind == Kind::kInput) return;
+  CountUses(node.lhs);
+  if (node.rhs >= 0) CountUses(node.rhs);
+}
+
+int S21MatrixGraph::Simplify(int id) {
+  auto it = simplified_.find(id);
+  if (it != simplified_.end()) return it->second;
+
+  Node node = nodes_[id];
+  int result = id;
+  if (node.kind == Kind::kTranspose) {
+    int child = Simplify(node.lhs);
+    result = nodes_[child].kind == Kind::kTranspose
+                 ? nodes_[child].lhs
+                 : Make(Kind::kTranspose, child, -1, 0);
+  } else if (node.kind == Kind::kMul) {
+    std::vector<int> factors;
+    CollectFactors(id, factors);
+    std::vector<int> dims(1, nodes_[factors[0]].rows);
+    for (int factor : factors) dims.push_back(nodes_[factor].cols);
+    std::vector<std::vector<int>> split = S21Matrix::ChainOrder(dims);
+    int last = static_cast<int>(factors.size()) - 1;
+    result = BuildChain(factors, split, 0, last);
+  } else if (node.kind != Kind::kInput) {
+    int rhs = node.rhs >= 0 ? Simplify(node.rhs) : -1;
+    result = Make(node.kind, Simplify(node.lhs), rhs, node.scalar);
+  }
+  simplified_[id] = result;
+  return result;
+}
+
+void S21MatrixGraph::CollectFactors(int id, std::vector<int>& factors) {
+  Node node = nodes_[id];
+  for (int side : {node.lhs, node.rhs}) {
+    // Общие произведения оставляем целыми, чтобы не терять их переиспользование
+    if (nodes_[side].kind == Kind::kMul && uses_[side] == 1) {
+      CollectFactors(side, factors);
+    } else {
+      factors.push_back(Simplify(side));
+    }
+  }
+}
+
+int S21MatrixGraph::BuildChain(const std::vector<int>& factors,
+                               const std::vector<std::vector<int>>& split,
+                               int i, int j) {
+  if (i == j) return factors[i];
+  int k = split[i][j];
+  return Make(Kind::kMul, BuildChain(factors, split, i, k),
+              BuildChain(factors, split, k + 1, j), 0);
+}
+
+const S21Matrix& S21MatrixGraph::Value(int id) {
+  const Node& node = nodes_[id];
+  if (node.kind == Kind::kInput) return *node.input;
+  auto it = values_.find(id);
+  if (it == values_.end()) it = values_.emplace(id, Compute(id)).first;
+  return it->second;
+}
+
+void S21MatrixGraph::Release(int id) {
+  if (--uses_[id] == 0) values_.erase(id);
+}
+
+S21Matrix S21MatrixGraph::Compute(int id) {
+  Node node = nodes_[id];
+  if (node.kind == Kind::kInput) return *node.input;
+
+  if (node.kind == Kind::kMul) {
+    int lhs = node.lhs;
+    int rhs = node.rhs;
+    bool transA = false;
+    bool transB = false;
+    // Транспонирование, нужное только этому умножению, не материализуем
+    if (nodes_[lhs].kind == Kind::kTranspose && uses_[lhs] == 1) {
+      lhs = nodes_[lhs].lhs;
+      transA = true;
+    }
+    if (nodes_[rhs].kind == Kind::kTranspose && uses_[rhs] == 1) {
+      rhs = nodes_[rhs].lhs;
+      transB = true;
+    }
+    const S21Matrix& a = Value(lhs);
+    const S21Matrix& b = Value(rhs);
+    S21Matrix result = S21Matrix::Gemm(a, transA, b, transB, nullptr);
+    stats_.multiplications++;
+    stats_.flops += static_cast<long long>(node.rows) *
+                    nodes_[node.lhs].cols * node.cols;
+    Release(lhs);
+    Release(rhs);
+    return result;
+  }
+
+  if (node.kind == Kind::kTranspose) {
+    S21Matrix result = Value(node.lhs).Transpose();
+    stats_.transposes++;
+    Release(node.lhs);
+    return result;
+  }
+
+  // Сумма, разность и умножение на число сливаются в один проход
+  std::vector<Term> terms;
+  std::vector<int> leaves;
+  CollectTerms(id, 1.0, false, true, terms, leaves);
+  S21Matrix result = S21Matrix::Uninitialized(node.rows, node.cols);
+  for (int i = 0; i < node.rows; ++i) {
+    double* out = result.matrix_[i];
+    for (int j = 0; j < node.cols; ++j) out[j] = 0;
+    for (const Term& term : terms) {
+      double** source = term.matrix->matrix_;
+      if (term.transposed) {
+        for (int j = 0; j < node.cols; ++j) out[j] += term.coef * source[j][i];
+      } else {
+        const double* row = source[i];
+        for (int j = 0; j < node.cols; ++j) out[j] += term.coef * row[j];
+      }
+    }
+  }
+  stats_.fusedPasses++;
+  for (int leaf : leaves) Release(leaf);
+  return result;
+}
+
+void S21MatrixGraph::CollectTerms(int id, double coef, bool transposed,
+                                  bool root, std::vector<Term>& terms,
+                                  std::vector<int>& leaves) {
+  Node node = nodes_[id];
+  bool inner = root || (uses_[id] == 1 && values_.count(id) == 0);
+  if (inner && node.kind == Kind::kSum) {
+    CollectTerms(node.lhs, coef, transposed, false, terms, leaves);
+    CollectTerms(node.rhs, coef, transposed, false, terms, leaves);
+  } else if (inner && node.kind == Kind::kSub) {
+    CollectTerms(node.lhs, coef, transposed, false, terms, leaves);
+    CollectTerms(node.rhs, -coef, transposed, false, terms, leaves);
+  } else if (inner && node.kind == Kind::kScale) {
+    CollectTerms(node.lhs, coef * node.scalar, transposed, false, terms,
+                 leaves);
+  } else if (inner && node.kind == Kind::kTranspose) {
+    CollectTerms(node.lhs, coef, !transposed, false, terms, leaves);
+  } else {
+    terms.push_back({coef, &Value(id), transposed});
+    leaves.push_back(id);
+  }
+}
@@ -0,0 +1,106 @@
+#ifndef S21_MATRIX_GRAPH_H
+#define S21_MATRIX_GRAPH_H
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+class S21MatrixGraph;
+
+// Отложенное выражение: операции только записываются в граф. Выражения
+// разных графов смешивать нельзя.
+class S21MatrixExpr {
+ public:
+  int GetRows() const;
+  int GetCols() const;
+
+  S21MatrixExpr operator+(const S21MatrixExpr& other) const;
+  S21MatrixExpr operator-(const S21MatrixExpr& other) const;
+  S21MatrixExpr operator*(const S21MatrixExpr& other) const;
+  S21MatrixExpr operator*(double num) const;
+  S21MatrixExpr Transpose() const;
+  S21Matrix Evaluate() const;
+
+ private:
+  S21MatrixGraph* graph_;
+  int id_;
+
+  S21MatrixExpr(S21MatrixGraph* graph, int id);
+
+  friend class S21MatrixGraph;
+};
+
+// Граф отложенных вычислений. Одинаковые подвыражения записываются один раз,
+// перед вычислением цепочки умножений переставляются в оптимальном порядке,
+// поэлементные операции сливаются в один проход, а транспонирование перед
+// умножением выполняется без создания промежуточной матрицы.
+// Входные матрицы не копируются и должны жить дольше графа.
+class S21MatrixGraph {
+ public:
+  // Статистика последнего вычисления
+  struct Stats {
+    int multiplications;
+    long long flops;
+    int transposes;
+    int fusedPasses;
+  };
+
+  S21MatrixGraph();
+  S21MatrixGraph(const S21MatrixGraph& other) = delete;
+  S21MatrixGraph& operator=(const S21MatrixGraph& other) = delete;
+
+  S21MatrixExpr Input(const S21Matrix& matrix);
+  S21Matrix Evaluate(const S21MatrixExpr& expr);
+  int GetNodeCount() const;
+  Stats GetStats() const;
+
+ private:
+  enum class Kind { kInput, kSum, kSub, kScale, kMul, kTranspose };
+
+  struct Node {
+    Kind kind;
+    int lhs;
+    int rhs;
+    double scalar;
+    int rows;
+    int cols;
+    const S21Matrix* input;
+  };
+
+  struct Term {
+    double coef;
+    const S21Matrix* matrix;
+    bool transposed;
+  };
+
+  std::vector<Node> nodes_;
+  // Множитель хранится битами: NaN нарушил бы порядок ключей std::map
+  std::map<std::tuple<int, int, int, std::uint64_t>, int> known_;
+  std::map<const S21Matrix*, int> inputs_;
+  Stats stats_;
+
+  // Состояние текущего вычисления
+  std::vector<int> uses_;
+  std::unordered_map<int, int> simplified_;
+  std::unordered_map<int, S21Matrix> values_;
+
+  int Make(Kind kind, int lhs, int rhs, double scalar);
+  void CountUses(int id);
+  int Simplify(int id);
+  void CollectFactors(int id, std::vector<int>& factors);
+  int BuildChain(const std::vector<int>& factors,
+                 const std::vector<std::vector<int>>& split, int i, int j);
+  const S21Matrix& Value(int id);
+  void Release(int id);
+  S21Matrix Compute(int id);
+  void CollectTerms(int id, double coef, bool transposed, bool root,
+                    std::vector<Term>& terms, std::vector<int>& leaves);
+
+  friend class S21MatrixExpr;
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "s21_matrix_numa.h"
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Значения из linux/mempolicy.h, чтобы не зависеть от libnuma
+static constexpr int kPolicyPreferred = 1;
+static constexpr int kPolicyInterleave = 3;
+static constexpr unsigned long kPolicyNode = 1;
+static constexpr unsigned long kPolicyAddress = 2;
+
+static std::atomic<S21MatrixNuma::Placement> placement(
+    S21MatrixNuma::Placement::kFirstTouch);
+
+int S21MatrixNuma::GetNodeCount() {
+  static const int count = [] {
+    int nodes = static_cast<int>(
+        ParseList("/sys/devices/system/node/online").size());
+    return nodes > 0 ? nodes : 1;
+  }();
+  return count;
+}
+
+std::vector<int> S21MatrixNuma::GetNodeCpus(int node) {
+  std::string path =
+      "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+  return ParseList(path.c_str());
+}
+
+void S21MatrixNuma::SetPlacement(Placement value) { placement = value; }
+
+S21MatrixNuma::Placement S21MatrixNuma::GetPlacement() { return placement; }
+
+bool S21MatrixNuma::Place(void* data, std::size_t bytes) {
+  bool placed = false;
+#ifdef __linux__
+  Placement current = GetPlacement();
+  if (current != Placement::kFirstTouch && GetNodeCount() > 1) {
+    // mbind принимает только целые страницы
+    std::uintptr_t page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data);
+    std::uintptr_t end = (begin + bytes) / page * page;
+    begin = (begin + page - 1) / page * page;
+    // MPOL_LOCAL выбрал бы узел потока, первым тронувшего страницу, то
+    // есть потока пула, поэтому узел вызывающего потока задаётся явно
+    int policy = kPolicyPreferred;
+    std::vector<int> nodes(1, GetCurrentNode());
+    if (current == Placement::kInterleave) {
+      policy = kPolicyInterleave;
+      nodes = ParseList("/sys/devices/system/node/online");
+    }
+    std::vector<unsigned long> mask;
+    const int bits = 8 * sizeof(unsigned long);
+    for (int node : nodes) {
+      if (node < 0) continue;
+      if (node / bits >= static_cast<int>(mask.size())) {
+        mask.resize(node / bits + 1, 0);
+      }
+      mask[node / bits] |= 1UL << (node % bits);
+    }
+    if (end > begin && !mask.empty()) {
+      // Ядро уменьшает maxnode на единицу перед чтением маски
+      unsigned long maxNode = mask.size() * bits + 1;
+      placed = syscall(SYS_mbind, begin, end - begin, policy, mask.data(),
+                       maxNode, 0) == 0;
+    }
+  }
+#else
+  (void)data;
+  (void)bytes;
+#endif
+  return placed;
+}
+
+int S21MatrixNuma::GetNode(const void* address) {
+  int node = -1;
+#ifdef __linux__
+  if (syscall(SYS_get_mempolicy, &node, nullptr, 0, address,
+              kPolicyNode | kPolicyAddress) != 0) {
+    node = -1;
+  }
+#else
+  (void)address;
+#endif
+  return node;
+}
+
+int S21MatrixNuma::GetCurrentNode() {
+  int node = -1;
+#ifdef __linux__
+  unsigned cpu = 0;
+  unsigned current = 0;
+  if (syscall(SYS_getcpu, &cpu, &current, nullptr) == 0) {
+    node = static_cast<int>(current);
+  }
+#endif
+  return node;
+}
+
+bool S21MatrixNuma::PinThread(int index) {
+  bool pinned = false;
+#ifdef __linux__
+  if (GetNodeCount() > 1) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : GetNodeCpus(index % GetNodeCount())) {
+      if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    pinned = CPU_COUNT(&set) > 0 &&
+             sched_setaffinity(0, sizeof(set), &set) == 0;
+  }
+#else
+  (void)index;
+#endif
+  return pinned;
+}
+
+std::vector<int> S21MatrixNuma::ParseList(const char* path) {
+  // Формат списков в /sys: "0-3,8,10-11"
+  std::vector<int> result;
+  std::ifstream file(path);
+  std::string range;
+  while (std::getline(file, range, ',')) {
+    std::size_t dash = range.find('-');
+    try {
+      int first = std::stoi(range);
+      int last = dash == std::string::npos ? first
+                                           : std::stoi(range.substr(dash + 1));
+      for (int i = first; i <= last; ++i) result.push_back(i);
+    } catch (const std::exception&) {
+      break;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,42 @@
+#ifndef S21_MATRIX_NUMA_H
+#define S21_MATRIX_NUMA_H
+
+#include <cstddef>
+#include <vector>
+
+// Размещение данных больших матриц по узлам NUMA и привязка потоков пула.
+// Топология читается из /sys, политики задаются системными вызовами
+// mbind и get_mempolicy. На машине с одним узлом и вне Linux все вызовы
+// ничего не делают.
+class S21MatrixNuma {
+ public:
+  enum class Placement {
+    // Страница попадает на узел потока, первым записавшего в неё
+    kFirstTouch,
+    // Страницы распределяются по всем узлам по очереди
+    kInterleave,
+    // Страницы выделяются на узле потока, создающего матрицу, хотя
+    // заполняют их потоки пула; если узел заполнен - на соседних
+    kLocal
+  };
+
+  static int GetNodeCount();
+  static std::vector<int> GetNodeCpus(int node);
+  static void SetPlacement(Placement placement);
+  static Placement GetPlacement();
+
+  // Применяет текущую политику к страницам, целиком лежащим в
+  // [data, data + bytes). Возвращает false, если политика не менялась.
+  static bool Place(void* data, std::size_t bytes);
+  // Узел, на котором лежит страница с адресом, или -1
+  static int GetNode(const void* address);
+  // Узел процессора, на котором выполняется текущий поток, или -1
+  static int GetCurrentNode();
+  // Привязывает текущий поток к процессорам узла index % GetNodeCount()
+  static bool PinThread(int index);
+
+ private:
+  static std::vector<int> ParseList(const char* path);
+};
+
+#endif
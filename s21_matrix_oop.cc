@@ -1,30 +1,151 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <vector>
 
+#include "s21_matrix_async.h"
+#include "s21_matrix_cache.h"
+#include "s21_matrix_decomposition.h"
 #include "s21_matrix_exception.h"
+#include "s21_matrix_executor.h"
+#include "s21_matrix_numa.h"
+
+struct S21Matrix::Block {
+  std::atomic<int> refs;
+  // Версия содержимого, растёт при каждом разрешении на запись
+  std::atomic<std::uint64_t> generation;
+  // Кеш хеша содержимого, действителен при hashGeneration == generation
+  std::atomic<std::uint64_t> hash;
+  std::atomic<std::uint64_t> hashGeneration;
+  std::atomic<bool> hasNan;
+  // Через operator() выдана ссылка на элемент, копии блока всегда полные
+  std::atomic<bool> referenced;
+  // Наружу выдан постоянный указатель (Data, Wrap): запись через него не
+  // меняет версию, поэтому хеш такого блока не кешируется
+  std::atomic<bool> exposed;
+  // Выделено строк и элементов в строке, может быть больше rows_ и cols_
+  int capacity;
+  int stride;
+  // Данные принадлежат вызывающему коду (Wrap) и могут меняться извне
+  bool external;
+  double* data;
+  double** rows;
+};
+
+static std::atomic<bool> copyOnWrite(false);
+
+// LU-разложение из кеша или вычисленное заново и сохранённое в нём
+static std::shared_ptr<const S21MatrixDecomposition::LU> Factorize(
+    const S21Matrix& matrix) {
+  S21MatrixCache& cache = S21MatrixCache::Instance();
+  std::shared_ptr<const S21MatrixDecomposition::LU> lu = cache.FindLU(matrix);
+  if (lu == nullptr) {
+    lu = std::make_shared<const S21MatrixDecomposition::LU>(
+        S21MatrixDecomposition::PartialPivotLU(matrix));
+    cache.StoreLU(matrix, *lu);
+  }
+  return lu;
+}
 
-S21Matrix::S21Matrix() : rows_(3), cols_(3) { CreateMatrix(); }
+S21Matrix::S21Matrix()
+    : rows_(3), cols_(3), matrix_(nullptr), block_(nullptr) {
+  CreateMatrix();
+}
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+S21Matrix::S21Matrix(int rows, int cols)
+    : rows_(rows), cols_(cols), matrix_(nullptr), block_(nullptr) {
   CreateMatrix();
 }
 
+S21Matrix::S21Matrix(int rows, int cols, Init init)
+    : rows_(rows), cols_(cols), matrix_(nullptr), block_(nullptr) {
+  CreateMatrix(init);
+}
+
+S21Matrix::S21Matrix(int rows, int cols, Block* block)
+    : rows_(rows), cols_(cols), matrix_(block->rows), block_(block) {}
+
+S21Matrix S21Matrix::Uninitialized(int rows, int cols) {
+  return S21Matrix(rows, cols, Init::kUninitialized);
+}
+
+S21Matrix S21Matrix::Zeros(int rows, int cols) {
+  return S21Matrix(rows, cols, Init::kZeros);
+}
+
+S21Matrix S21Matrix::Identity(int size) {
+  S21Matrix result(size, size, Init::kZeros);
+  for (int i = 0; i < size; ++i) result.matrix_[i][i] = 1.0;
+  return result;
+}
+
+S21Matrix S21Matrix::Wrap(double* data, int rows, int cols, int stride) {
+  S21MatrixException::CheckRows(rows);
+  S21MatrixException::CheckCols(cols);
+  S21MatrixException::CheckStride(data, cols, stride);
+  std::unique_ptr<Block> block(new Block{{1}, {1}, {0}, {0}, {false},
+                                         {false}, {true}, rows, stride, true,
+                                         data, nullptr});
+  block->rows = new double*[rows];
+  for (int i = 0; i < rows; ++i) {
+    block->rows[i] = data + static_cast<std::size_t>(i) * stride;
+  }
+  return S21Matrix(rows, cols, block.release());
+}
+
+S21Matrix S21Matrix::Filled(int rows, int cols, double value) {
+  S21Matrix result(rows, cols, Init::kUninitialized);
+  result.Fill(value);
+  return result;
+}
+
 S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(other.matrix_),
+      block_(other.block_) {
   other.rows_ = 0;
   other.cols_ = 0;
   other.matrix_ = nullptr;
+  other.block_ = nullptr;
 }
 
-
-S21Matrix::S21Matrix(const S21Matrix& other) : rows_(other.rows_), cols_(other.cols_) {
-  CreateMatrix();
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
+S21Matrix::S21Matrix(const S21Matrix& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(nullptr),
+      block_(nullptr) {
+  // Чужой буфер и блок с выданными ссылками могут измениться в обход
+  // Detach, поэтому их копии всегда полные
+  if (IsCopyOnWrite() && other.block_ != nullptr &&
+      !other.block_->referenced.load(std::memory_order_relaxed) &&
+      !other.block_->exposed.load(std::memory_order_relaxed)) {
+    block_ = other.block_;
+    block_->refs.fetch_add(1, std::memory_order_relaxed);
+    matrix_ = other.matrix_;
+  } else {
+    CreateMatrix(Init::kUninitialized);
+    double** source = other.matrix_;
+    double** target = matrix_;
+    int cols = cols_;
+    ForRows(rows_, cols_, [source, target, cols](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        std::memcpy(target[i], source[i], cols * sizeof(double));
+      }
+    });
+    // Копия наследует уже вычисленный хеш
+    std::uint64_t hash = 0;
+    bool hasNan = false;
+    if (other.CachedHash(hash, hasNan)) CacheHash(hash, hasNan);
   }
 }
 
@@ -33,39 +154,211 @@ S21Matrix::~S21Matrix() { RemoveMatrix(); }
 int S21Matrix::GetRows() const { return rows_; }
 int S21Matrix::GetCols() const { return cols_; }
 
+void S21Matrix::SetCopyOnWrite(bool enabled) { copyOnWrite = enabled; }
+
+bool S21Matrix::IsCopyOnWrite() { return copyOnWrite; }
+
+bool S21Matrix::IsShared() const {
+  return block_ != nullptr &&
+         block_->refs.load(std::memory_order_acquire) > 1;
+}
+
 void S21Matrix::SetRows(int rows) {
   S21MatrixException::CheckRows(rows);
-  S21Matrix resultMatrix(rows, cols_);
-  for (int i = 0; i < rows; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      resultMatrix.matrix_[i][j] = i < rows_ ? matrix_[i][j] : 0.0;
-    }
+  // У перенесённой матрицы нет ни блока, ни столбцов
+  S21MatrixException::CheckCols(cols_);
+  // Запас чужого буфера принадлежит вызывающему коду, поэтому рост
+  // обёртки сначала переносит данные в собственную память. Общий блок
+  // копируется сразу в новый размер, а не отделяется отдельным проходом
+  if (rows > rows_ && block_->external) {
+    Reallocate(rows, cols_);
+  } else if (rows > GetCapacity()) {
+    Reallocate(std::max(rows, 2 * GetCapacity()), GetStride());
+  } else {
+    Detach();
   }
-  *this = std::move(resultMatrix);
+  // Уменьшение только сдвигает границу, память остаётся в запасе
+  for (int i = rows_; i < rows; ++i) {
+    std::fill(matrix_[i], matrix_[i] + cols_, 0.0);
+  }
+  rows_ = rows;
 }
 
 void S21Matrix::SetCols(int cols) {
   S21MatrixException::CheckCols(cols);
-  S21Matrix resultMatrix(rows_, cols);
+  S21MatrixException::CheckRows(rows_);
+  // Лишние столбцы остаются в шаге строки и переиспользуются при росте
+  if (cols > cols_ && block_->external) {
+    Reallocate(rows_, cols);
+  } else if (cols > GetStride()) {
+    Reallocate(GetCapacity(), cols);
+  } else {
+    Detach();
+  }
+  for (int i = 0; cols > cols_ && i < rows_; ++i) {
+    std::fill(matrix_[i] + cols_, matrix_[i] + cols, 0.0);
+  }
+  cols_ = cols;
+}
+
+void S21Matrix::Reserve(int rows, int cols) {
+  S21MatrixException::CheckRows(rows);
+  S21MatrixException::CheckCols(cols);
+  if (rows > GetCapacity() || cols > GetStride()) {
+    Reallocate(std::max(rows, GetCapacity()), std::max(cols, GetStride()));
+  }
+}
+
+void S21Matrix::AppendRow(const std::vector<double>& values) {
+  S21MatrixException::CheckDimensions(1, cols_, 1,
+                                      static_cast<int>(values.size()));
+  if (rows_ == GetCapacity() || block_->external) {
+    Reallocate(std::max(rows_ + 1, 2 * GetCapacity()), GetStride());
+  } else {
+    Detach();
+  }
+  std::copy(values.begin(), values.end(), matrix_[rows_]);
+  ++rows_;
+}
+
+void S21Matrix::ShrinkToFit() {
+  // Буфер обёртки принадлежит вызывающему, освобождать в нём нечего
+  if (block_ == nullptr || block_->external) return;
+  if (GetCapacity() != rows_ || GetStride() != cols_) {
+    Reallocate(rows_, cols_);
+  }
+}
+
+int S21Matrix::GetCapacity() const {
+  return block_ != nullptr ? block_->capacity : 0;
+}
+
+int S21Matrix::GetStride() const {
+  return block_ != nullptr ? block_->stride : 0;
+}
+
+bool S21Matrix::EqMatrix(const S21Matrix& other) const {
+  bool areEqual = rows_ == other.rows_ && cols_ == other.cols_;
+  std::uint64_t hash = 0;
+  std::uint64_t otherHash = 0;
+  bool hasNan = false;
+  bool otherHasNan = false;
+  if (areEqual && CachedHash(hash, hasNan) &&
+      other.CachedHash(otherHash, otherHasNan)) {
+    // Неизменённые матрицы сравниваются по хешам, NaN не равен ничему
+    areEqual = hash == otherHash && !hasNan && !otherHasNan;
+  } else if (areEqual) {
+    areEqual = CompareWith(other, [](double a, double b) { return a == b; });
+    // Содержимое совпало, поэтому один хеш подходит обеим матрицам, а
+    // повторное сравнение обойдётся без прохода по элементам
+    if (areEqual) other.CacheHash(GetHash(), false);
+  }
+  return areEqual;
+}
+
+bool S21Matrix::EqMatrix(const S21Matrix& other, double absTol,
+                         double relTol) const {
+  bool areEqual = rows_ == other.rows_ && cols_ == other.cols_;
+  if (areEqual && !SameData(other)) {
+    areEqual = CompareWith(other, [absTol, relTol](double a, double b) {
+      // Совпадающие бесконечности равны, хотя их разность - NaN, а
+      // бесконечная разность не укладывается ни в какой допуск
+      double difference = std::abs(a - b);
+      double scale = std::max(std::abs(a), std::abs(b));
+      return a == b || (difference <= std::numeric_limits<double>::max() &&
+                        difference <= std::max(absTol, relTol * scale));
+    });
+  }
+  return areEqual;
+}
+
+bool S21Matrix::EqMatrixUlp(const S21Matrix& other, long maxUlps) const {
+  S21MatrixException::CheckUlps(maxUlps);
+  bool areEqual = rows_ == other.rows_ && cols_ == other.cols_;
+  if (areEqual && !SameData(other)) {
+    areEqual = CompareWith(other, [maxUlps](double a, double b) {
+      // Отображение в целые, монотонное по значению: соседние double
+      // отличаются на единицу, +0 и -0 совпадают
+      std::int64_t x;
+      std::int64_t y;
+      std::memcpy(&x, &a, sizeof(x));
+      std::memcpy(&y, &b, sizeof(y));
+      if (x < 0) x = std::numeric_limits<std::int64_t>::min() - x;
+      if (y < 0) y = std::numeric_limits<std::int64_t>::min() - y;
+      std::uint64_t distance = x > y ? static_cast<std::uint64_t>(x) - y
+                                     : static_cast<std::uint64_t>(y) - x;
+      return a == a && b == b &&
+             distance <= static_cast<std::uint64_t>(maxUlps);
+    });
+  }
+  return areEqual;
+}
+
+std::uint64_t S21Matrix::GetHash() const {
+  std::uint64_t hash = 0;
+  bool hasNan = false;
+  if (CachedHash(hash, hasNan)) return hash;
+  hash = 0x9E3779B97F4A7C15ULL ^ (static_cast<std::uint64_t>(rows_) << 32) ^
+         static_cast<std::uint64_t>(cols_);
   for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols; ++j) {
-      resultMatrix.matrix_[i][j] = j < cols_ ? matrix_[i][j] : 0.0;
+    for (int j = 0; j < cols_; ++j) {
+      double value = matrix_[i][j];
+      // -0.0 == 0.0, поэтому у них должен быть одинаковый хеш
+      if (value == 0) value = 0;
+      hasNan = hasNan || value != value;
+      std::uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      hash = (hash ^ bits) * 0xFF51AFD7ED558CCDULL;
+      hash ^= hash >> 32;
     }
   }
-  *this = std::move(resultMatrix);
+  CacheHash(hash, hasNan);
+  return hash;
+}
+
+bool S21Matrix::CachedHash(std::uint64_t& hash, bool& hasNan) const {
+  bool cached = block_ != nullptr &&
+                block_->hashGeneration.load(std::memory_order_acquire) ==
+                    block_->generation.load(std::memory_order_relaxed);
+  if (cached) {
+    hash = block_->hash.load(std::memory_order_relaxed);
+    hasNan = block_->hasNan.load(std::memory_order_relaxed);
+  }
+  return cached;
+}
+
+void S21Matrix::CacheHash(std::uint64_t hash, bool hasNan) const {
+  if (block_ != nullptr && !block_->exposed.load(std::memory_order_relaxed)) {
+    block_->hash.store(hash, std::memory_order_relaxed);
+    block_->hasNan.store(hasNan, std::memory_order_relaxed);
+    block_->hashGeneration.store(
+        block_->generation.load(std::memory_order_relaxed),
+        std::memory_order_release);
+  }
+}
+
+bool S21Matrix::SameData(const S21Matrix& other) const {
+  // Общий блок равен сам себе, если в нём нет NaN
+  std::uint64_t hash = 0;
+  bool hasNan = true;
+  return block_ != nullptr && block_ == other.block_ &&
+         CachedHash(hash, hasNan) && !hasNan;
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
+template <typename Predicate>
+bool S21Matrix::CompareWith(const S21Matrix& other, Predicate same) const {
+  // Внутри блока нет ветвлений, поэтому цикл векторизуется,
+  // а выход происходит по итогам всего блока
+  constexpr int kBlock = 64;
   bool areEqual = true;
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    areEqual = false;
-  } else {
-    for (int i = 0; areEqual && i < rows_; ++i) {
-      for (int j = 0; areEqual && j < cols_; ++j) {
-        if (matrix_[i][j] != other.matrix_[i][j]) {
-          areEqual = false;
-        }
-      }
+  for (int i = 0; areEqual && i < rows_; ++i) {
+    const double* a = matrix_[i];
+    const double* b = other.matrix_[i];
+    for (int from = 0; areEqual && from < cols_; from += kBlock) {
+      int to = std::min(cols_, from + kBlock);
+      bool blockEqual = true;
+      for (int j = from; j < to; ++j) blockEqual &= same(a[j], b[j]);
+      areEqual = blockEqual;
     }
   }
   return areEqual;
@@ -73,6 +366,7 @@ bool S21Matrix::EqMatrix(const S21Matrix& other) {
 
 void S21Matrix::SumMatrix(const S21Matrix& other) {
   S21MatrixException::CheckDimensions(*this, other);
+  Detach();
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
       matrix_[i][j] += other.matrix_[i][j];
@@ -82,6 +376,7 @@ void S21Matrix::SumMatrix(const S21Matrix& other) {
 
 void S21Matrix::SubMatrix(const S21Matrix& other) {
   S21MatrixException::CheckDimensions(*this, other);
+  Detach();
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
       matrix_[i][j] -= other.matrix_[i][j];
@@ -90,6 +385,7 @@ void S21Matrix::SubMatrix(const S21Matrix& other) {
 }
 
 void S21Matrix::MulNumber(const double num) {
+  Detach();
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
       matrix_[i][j] *= num;
@@ -98,21 +394,149 @@ void S21Matrix::MulNumber(const double num) {
 }
 
 void S21Matrix::MulMatrix(const S21Matrix& other) {
-  S21MatrixException::CheckMultiplication(*this, other);
-  S21Matrix resultMatrix(rows_, other.cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      resultMatrix.matrix_[i][j] = 0;
-      for (int k = 0; k < cols_; ++k) {
-        resultMatrix.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
+  *this = Product(other, nullptr);
+}
+
+S21Matrix S21Matrix::Product(const S21Matrix& other,
+                             S21MatrixProgress* progress) const {
+  return Gemm(*this, false, other, false, progress);
+}
+
+S21Matrix S21Matrix::Gemm(const S21Matrix& a, bool transA, const S21Matrix& b,
+                          bool transB, S21MatrixProgress* progress) {
+  int rows = transA ? a.cols_ : a.rows_;
+  int inner = transA ? a.rows_ : a.cols_;
+  int cols = transB ? b.rows_ : b.cols_;
+  S21MatrixException::CheckMultiplication(inner, transB ? b.cols_ : b.rows_);
+  S21Matrix resultMatrix = Uninitialized(rows, cols);
+  if (progress != nullptr) progress->SetTotal(rows);
+  for (int i = 0; i < rows; ++i) {
+    if (progress != nullptr) progress->Report(i);
+    double* out = resultMatrix.matrix_[i];
+    if (transB) {
+      // Строки B^T лежат в памяти подряд, считаем скалярные произведения
+      for (int j = 0; j < cols; ++j) {
+        double sum = 0;
+        for (int k = 0; k < inner; ++k) {
+          sum += (transA ? a.matrix_[k][i] : a.matrix_[i][k]) * b.matrix_[j][k];
+        }
+        out[j] = sum;
+      }
+    } else {
+      for (int j = 0; j < cols; ++j) out[j] = 0;
+      for (int k = 0; k < inner; ++k) {
+        double aik = transA ? a.matrix_[k][i] : a.matrix_[i][k];
+        const double* row = b.matrix_[k];
+        for (int j = 0; j < cols; ++j) out[j] += aik * row[j];
       }
     }
   }
-  *this = std::move(resultMatrix);
+  if (progress != nullptr) progress->Report(rows);
+  return resultMatrix;
+}
+
+std::vector<std::vector<int>> S21Matrix::ChainOrder(
+    const std::vector<int>& dims) {
+  int count = static_cast<int>(dims.size()) - 1;
+  std::vector<std::vector<double>> cost(count, std::vector<double>(count, 0));
+  std::vector<std::vector<int>> split(count, std::vector<int>(count, 0));
+  for (int length = 2; length <= count; ++length) {
+    for (int i = 0; i + length - 1 < count; ++i) {
+      int j = i + length - 1;
+      cost[i][j] = -1;
+      for (int k = i; k < j; ++k) {
+        double current = cost[i][k] + cost[k + 1][j] +
+                         static_cast<double>(dims[i]) * dims[k + 1] *
+                             dims[j + 1];
+        if (cost[i][j] < 0 || current < cost[i][j]) {
+          cost[i][j] = current;
+          split[i][j] = k;
+        }
+      }
+    }
+  }
+  return split;
+}
+
+S21Matrix S21Matrix::MultiplyChain(
+    std::initializer_list<const S21Matrix*> matrices) {
+  std::vector<const S21Matrix*> factors(matrices);
+  S21MatrixException::CheckChain(static_cast<int>(factors.size()));
+  std::vector<int> dims(1, factors[0]->rows_);
+  for (std::size_t i = 0; i < factors.size(); ++i) {
+    if (i > 0) {
+      S21MatrixException::CheckMultiplication(*factors[i - 1], *factors[i]);
+    }
+    dims.push_back(factors[i]->cols_);
+  }
+  int last = static_cast<int>(factors.size()) - 1;
+  if (last == 0) return *factors[0];
+  std::vector<std::vector<int>> split = ChainOrder(dims);
+  S21Matrix resultMatrix = Uninitialized(dims[0], dims.back());
+  // Все промежуточные произведения размещаются в одном буфере
+  std::vector<double> scratch(ChainScratch(dims, split, 0, last));
+  MultiplyChain(factors, dims, split, 0, last, resultMatrix.matrix_[0],
+                scratch.data());
+  return resultMatrix;
+}
+
+std::size_t S21Matrix::ChainScratch(const std::vector<int>& dims,
+                                    const std::vector<std::vector<int>>& split,
+                                    int i, int j) {
+  if (i == j) return 0;
+  int k = split[i][j];
+  std::size_t left =
+      k > i ? static_cast<std::size_t>(dims[i]) * dims[k + 1] : 0;
+  std::size_t right =
+      j > k + 1 ? static_cast<std::size_t>(dims[k + 1]) * dims[j + 1] : 0;
+  return std::max(left + ChainScratch(dims, split, i, k),
+                  left + right + ChainScratch(dims, split, k + 1, j));
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix resultMatrix(cols_, rows_);
+void S21Matrix::MultiplyChain(const std::vector<const S21Matrix*>& factors,
+                              const std::vector<int>& dims,
+                              const std::vector<std::vector<int>>& split,
+                              int i, int j, double* out, double* scratch) {
+  int k = split[i][j];
+  // Исходные матрицы читаются на месте, с учётом шага их строк
+  const double* left = factors[i]->matrix_[0];
+  int leftStride = factors[i]->GetStride();
+  const double* right = factors[j]->matrix_[0];
+  int rightStride = factors[j]->GetStride();
+  double* next = scratch;
+  if (k > i) {
+    double* buffer = next;
+    next += static_cast<std::size_t>(dims[i]) * dims[k + 1];
+    MultiplyChain(factors, dims, split, i, k, buffer, next);
+    left = buffer;
+    leftStride = dims[k + 1];
+  }
+  if (j > k + 1) {
+    double* buffer = next;
+    next += static_cast<std::size_t>(dims[k + 1]) * dims[j + 1];
+    MultiplyChain(factors, dims, split, k + 1, j, buffer, next);
+    right = buffer;
+    rightStride = dims[j + 1];
+  }
+  MulKernel(left, leftStride, right, rightStride, out, dims[i], dims[k + 1],
+            dims[j + 1]);
+}
+
+void S21Matrix::MulKernel(const double* a, int lda, const double* b, int ldb,
+                          double* c, int rows, int inner, int cols) {
+  for (int i = 0; i < rows; ++i) {
+    double* out = c + static_cast<std::size_t>(i) * cols;
+    for (int j = 0; j < cols; ++j) out[j] = 0;
+    for (int k = 0; k < inner; ++k) {
+      double aik = a[static_cast<std::size_t>(i) * lda + k];
+      const double* row = b + static_cast<std::size_t>(k) * ldb;
+      for (int j = 0; j < cols; ++j) out[j] += aik * row[j];
+    }
+  }
+}
+
+S21Matrix S21Matrix::Transpose() const {
+  S21Matrix resultMatrix = Uninitialized(cols_, rows_);
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
       resultMatrix.matrix_[j][i] = matrix_[i][j];
@@ -122,7 +546,7 @@ S21Matrix S21Matrix::Transpose() {
 }
 
 S21Matrix S21Matrix::Minor(int row, int col) const {
-  S21Matrix minorMatrix(rows_ - 1, cols_ - 1);
+  S21Matrix minorMatrix = Uninitialized(rows_ - 1, cols_ - 1);
   int minorRow = 0;
   for (int i = 0; i < rows_; ++i) {
     if (i == row) continue;
@@ -138,37 +562,77 @@ S21Matrix S21Matrix::Minor(int row, int col) const {
 }
 
 double S21Matrix::Determinant() const {
+  S21MatrixException::CheckSquare(rows_, cols_);
+  if (rows_ <= kCofactorSize) return UncachedDeterminant();
+  double result = 0;
+  S21MatrixCache& cache = S21MatrixCache::Instance();
+  if (!cache.FindDeterminant(*this, result)) {
+    result = S21MatrixDecomposition::Determinant(*Factorize(*this));
+    cache.StoreDeterminant(*this, result);
+  }
+  return result;
+}
+
+double S21Matrix::UncachedDeterminant() const {
   S21MatrixException::CheckSquare(rows_, cols_);
   double result = 0;
   if (rows_ == 1) {
     result = matrix_[0][0];
   } else if (rows_ == 2) {
     result = matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
-  } else {
+  } else if (rows_ <= kCofactorSize) {
     for (int i = 0; i < cols_; ++i) {
       double sign = (i % 2 == 0) ? 1 : -1;
-      result += sign * matrix_[0][i] * Minor(0, i).Determinant();
+      result += sign * matrix_[0][i] * Minor(0, i).UncachedDeterminant();
     }
+  } else {
+    result = S21MatrixDecomposition::Determinant(
+        S21MatrixDecomposition::PartialPivotLU(*this));
   }
   return result;
 }
 
 S21Matrix S21Matrix::CalcComplements() const {
+  return CalcComplements(nullptr);
+}
+
+S21Matrix S21Matrix::CalcComplements(S21MatrixProgress* progress) const {
   S21MatrixException::CheckSquare(rows_, cols_);
-  S21Matrix complementsMatrix(rows_, cols_);
+  S21Matrix complementsMatrix = Uninitialized(rows_, cols_);
+  if (progress != nullptr) progress->SetTotal(rows_);
   for (int i = 0; i < rows_; ++i) {
+    if (progress != nullptr) progress->Report(i);
     for (int j = 0; j < cols_; ++j) {
       double sign = ((i + j) % 2 == 0) ? 1 : -1;
-      complementsMatrix.matrix_[i][j] = sign * Minor(i, j).Determinant();
+      complementsMatrix.matrix_[i][j] =
+          sign * Minor(i, j).UncachedDeterminant();
     }
   }
+  if (progress != nullptr) progress->Report(rows_);
   return complementsMatrix;
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
+S21Matrix S21Matrix::InverseMatrix() const { return InverseMatrix(nullptr); }
+
+S21Matrix S21Matrix::InverseMatrix(S21MatrixProgress* progress) const {
+  S21MatrixException::CheckSquare(rows_, cols_);
+  if (rows_ > kCofactorSize) {
+    S21MatrixCache& cache = S21MatrixCache::Instance();
+    std::shared_ptr<const S21Matrix> cached = cache.FindInverse(*this);
+    if (cached != nullptr) return *cached;
+    std::shared_ptr<const S21MatrixDecomposition::LU> lu = Factorize(*this);
+    S21MatrixException::CheckSingular(
+        S21MatrixDecomposition::Determinant(*lu));
+    S21Matrix inverse = S21MatrixDecomposition::Inverse(*lu, progress);
+    cache.StoreInverse(*this, inverse);
+    return inverse;
+  }
+  // Для маленьких матриц точнее и быстрее формула через дополнения
   double det = Determinant();
   S21MatrixException::CheckSingular(det);
-  S21Matrix complementsMatrix = CalcComplements();
+  // У матрицы 1 x 1 нет миноров, обратная - просто 1 / a
+  if (rows_ == 1) return Filled(1, 1, 1.0 / det);
+  S21Matrix complementsMatrix = CalcComplements(progress);
   S21Matrix transposedComplements = complementsMatrix.Transpose();
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
@@ -178,6 +642,19 @@ S21Matrix S21Matrix::InverseMatrix() const {
   return transposedComplements;
 }
 
+S21MatrixTask S21Matrix::MulMatrixAsync(const S21Matrix& other) const {
+  return S21MatrixTask::Mul(S21MatrixTask::Ready(*this),
+                            S21MatrixTask::Ready(other));
+}
+
+S21MatrixTask S21Matrix::CalcComplementsAsync() const {
+  return S21MatrixTask::Complements(S21MatrixTask::Ready(*this));
+}
+
+S21MatrixTask S21Matrix::InverseMatrixAsync() const {
+  return S21MatrixTask::Inverse(S21MatrixTask::Ready(*this));
+}
+
 S21Matrix S21Matrix::operator+(const S21Matrix& other) {
   S21Matrix tmpMatirx(*this);
   tmpMatirx.SumMatrix(other);
@@ -196,34 +673,56 @@ S21Matrix S21Matrix::operator*(double num) {
   return tmpMatrix;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix tmpMatrix(*this);
-  tmpMatrix.MulMatrix(other);
-  return tmpMatrix;
+S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
+  return Product(other, nullptr);
 }
 
 S21Matrix operator*(int scalar, const S21Matrix& matrix) {
-    S21Matrix result(matrix.GetRows(), matrix.GetCols());
+    S21Matrix result =
+        S21Matrix::Uninitialized(matrix.GetRows(), matrix.GetCols());
     for (int i = 0; i < matrix.GetRows(); ++i) {
         for (int j = 0; j < matrix.GetCols(); ++j) {
-            result(i, j) = scalar * matrix(i, j);
+            result.matrix_[i][j] = scalar * matrix(i, j);
         }
     }
     return result;
 }
 
 
-double& S21Matrix::operator()(int row, int col) const {
+double S21Matrix::Get(int row, int col) const {
+  S21MatrixException::CheckRange(row, col, rows_, cols_);
+  return matrix_[row][col];
+}
+
+void S21Matrix::Set(int row, int col, double value) {
+  S21MatrixException::CheckRange(row, col, rows_, cols_);
+  Detach();
+  matrix_[row][col] = value;
+}
+
+const double& S21Matrix::operator()(int row, int col) const {
   S21MatrixException::CheckRange(row, col, rows_, cols_);
   return matrix_[row][col];
 }
 
 double& S21Matrix::operator()(int row, int col){
   S21MatrixException::CheckRange(row, col, rows_, cols_);
+  Detach();
+  // Через ссылку можно писать и после следующего копирования
+  block_->referenced.store(true, std::memory_order_relaxed);
   return matrix_[row][col];
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) { return EqMatrix(other); }
+double* S21Matrix::Data() {
+  if (block_ == nullptr) return nullptr;
+  Detach();
+  block_->exposed.store(true, std::memory_order_relaxed);
+  return matrix_[0];
+}
+
+bool S21Matrix::operator==(const S21Matrix& other) const {
+  return EqMatrix(other);
+}
 
 // Перемещение
 S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
@@ -232,9 +731,11 @@ S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
     rows_ = other.rows_;
     cols_ = other.cols_;
     matrix_ = other.matrix_;
+    block_ = other.block_;
     other.cols_ = 0;
     other.rows_ = 0;
     other.matrix_ = nullptr;
+    other.block_ = nullptr;
   }
   return *this;
 }
@@ -267,24 +768,90 @@ S21Matrix& S21Matrix::operator*=(double num) {
   return *this;
 }
 
-void S21Matrix::CreateMatrix() {
+void S21Matrix::CreateMatrix(Init init) {
   S21MatrixException::CheckCols(cols_);
   S21MatrixException::CheckRows(rows_);
-  matrix_ = new double*[rows_];
-  for (int i = 0; i < rows_; ++i) {
-    matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = 2.0;
+  block_ = NewBlock(rows_, cols_, init == Init::kZeros);
+  matrix_ = block_->rows;
+  if (init == Init::kTwos) Fill(2.0);
+}
+
+void S21Matrix::Fill(double value) {
+  double** matrix = matrix_;
+  int cols = cols_;
+  ForRows(rows_, cols_, [matrix, cols, value](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      std::fill(matrix[i], matrix[i] + cols, value);
     }
-  }
+  });
 }
 
 void S21Matrix::RemoveMatrix() {
-  // Проверка, что указатель не равен nullptr
-  if (matrix_ != nullptr) {
-    for (int i = 0; i < rows_; ++i) delete[] matrix_[i];
-    delete[] matrix_;
-    matrix_ = nullptr;
+  // Блок освобождает последняя матрица, которая на него ссылается
+  if (block_ != nullptr &&
+      block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    if (!block_->external) std::free(block_->data);
+    delete[] block_->rows;
+    delete block_;
+  }
+  block_ = nullptr;
+  matrix_ = nullptr;
+}
+
+S21Matrix::Block* S21Matrix::NewBlock(int capacity, int stride,
+                                      bool zeroed) {
+  // Все элементы лежат одним блоком, строки - указатели внутрь него
+  std::size_t size = static_cast<std::size_t>(capacity) * stride;
+  // Указатели строк выделяются до данных, чтобы исключение из new не
+  // оставляло за собой занятую память
+  std::unique_ptr<Block> block(new Block{{1}, {1}, {0}, {0}, {false},
+                                         {false}, {false}, capacity, stride,
+                                         false, nullptr, nullptr});
+  std::unique_ptr<double*[]> rows(new double*[capacity]);
+  block->data = static_cast<double*>(
+      zeroed ? std::calloc(size, sizeof(double))
+             : std::malloc(size * sizeof(double)));
+  if (block->data == nullptr) throw std::bad_alloc();
+  if (static_cast<long>(size) >= kParallelSize) {
+    S21MatrixNuma::Place(block->data, size * sizeof(double));
+  }
+  for (int i = 0; i < capacity; ++i) {
+    rows[i] = block->data + static_cast<std::size_t>(i) * stride;
+  }
+  block->rows = rows.release();
+  return block.release();
+}
+
+void S21Matrix::ForRows(int rows, int cols,
+                        const std::function<void(int, int)>& body) {
+  if (static_cast<long>(rows) * cols >= kParallelSize) {
+    S21MatrixExecutor::Instance().ParallelForStatic(0, rows, body);
+  } else {
+    body(0, rows);
   }
 }
 
+void S21Matrix::Reallocate(int capacity, int stride) {
+  S21MatrixException::CheckRows(capacity);
+  S21MatrixException::CheckCols(stride);
+  Block* block = NewBlock(capacity, stride);
+  int rows = std::min(rows_, capacity);
+  int cols = std::min(cols_, stride);
+  double** source = matrix_;
+  ForRows(rows, cols, [block, source, cols](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      std::memcpy(block->rows[i], source[i], cols * sizeof(double));
+    }
+  });
+  RemoveMatrix();
+  block_ = block;
+  matrix_ = block->rows;
+}
+
+void S21Matrix::Detach() {
+  if (IsShared()) {
+    Reallocate(block_->capacity, block_->stride);
+  } else if (block_ != nullptr) {
+    block_->generation.fetch_add(1, std::memory_order_release);
+  }
+}
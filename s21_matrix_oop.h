@@ -1,6 +1,15 @@
 #ifndef S21_MATRIX_OOP_H
 #define S21_MATRIX_OOP_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+class S21MatrixProgress;
+class S21MatrixTask;
+
 class S21Matrix {
  public:
   S21Matrix();
@@ -11,14 +20,54 @@ class S21Matrix {
   S21Matrix(S21Matrix&& other) noexcept;
   ~S21Matrix();
 
+  // Фабрики без лишнего прохода заполнения двойками
+  static S21Matrix Uninitialized(int rows, int cols);
+  // Память берётся через calloc, большие блоки ОС обнуляет лениво
+  static S21Matrix Zeros(int rows, int cols);
+  static S21Matrix Identity(int size);
+  static S21Matrix Filled(int rows, int cols, double value);
+  // Матрица поверх чужого буфера по строкам с шагом stride, без копирования.
+  // Буфер должен жить дольше матрицы. Копии обёртки всегда полные, а
+  // увеличение размера, Reserve сверх буфера и AppendRow переносят данные
+  // в собственную память, после чего запись в буфер не попадает.
+  // ShrinkToFit у обёртки ничего не делает.
+  static S21Matrix Wrap(double* data, int rows, int cols, int stride);
+
   // Сеттеры и Геттеры
   int GetRows() const;
   int GetCols() const;
+  // Шаг между строками в элементах
+  int GetStride() const;
   void SetRows(int rows);
   void SetCols(int cols);
 
-  // Основные операции
-  bool EqMatrix(const S21Matrix& other);
+  // Запас памяти: добавление строк за амортизированное O(1)
+  void Reserve(int rows, int cols);
+  void AppendRow(const std::vector<double>& values);
+  void ShrinkToFit();
+  int GetCapacity() const;
+
+  // Режим копирования при записи: копии делят один блок данных,
+  // который дублируется только при первом изменении. Матрица, у которой
+  // брали ссылку через неконстантный operator(), копируется полностью:
+  // запись через ещё живую ссылку не должна попасть в копию
+  static void SetCopyOnWrite(bool enabled);
+  static bool IsCopyOnWrite();
+  bool IsShared() const;
+
+  // Основные операции. Матрицы с вычисленными хешами сравниваются за O(1),
+  // полное сравнение равных матриц заполняет кеш хеша
+  bool EqMatrix(const S21Matrix& other) const;
+  // Сравнение с допуском: |a - b| <= max(absTol, relTol * max(|a|, |b|))
+  bool EqMatrix(const S21Matrix& other, double absTol,
+                double relTol = 0) const;
+  // Сравнение с допуском в единицах последнего разряда
+  bool EqMatrixUlp(const S21Matrix& other, long maxUlps) const;
+  // Хеш содержимого, кешируется до следующего неконстантного вызова.
+  // Запись через ссылку из operator(), сохранённую дольше следующего
+  // сравнения или GetHash, кеш не замечает: для неё нужен новый вызов
+  // operator() или Set. У Wrap и после Data хеш не кешируется
+  std::uint64_t GetHash() const;
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
@@ -27,31 +76,111 @@ class S21Matrix {
   S21Matrix CalcComplements() const;
   S21Matrix Minor(int row, int col) const;
   S21Matrix InverseMatrix() const;
-  S21Matrix Transpose();
+  S21Matrix Transpose() const;
+  // Произведение цепочки матриц в оптимальном порядке скобок
+  static S21Matrix MultiplyChain(
+      std::initializer_list<const S21Matrix*> matrices);
+
+  // Асинхронные операции, см. s21_matrix_async.h
+  S21MatrixTask MulMatrixAsync(const S21Matrix& other) const;
+  S21MatrixTask CalcComplementsAsync() const;
+  S21MatrixTask InverseMatrixAsync() const;
+
+  // Чтение и запись элемента без выдачи ссылки: Get не отделяет общий
+  // блок, а после Set матрица по-прежнему копируется без дублирования
+  double Get(int row, int col) const;
+  void Set(int row, int col, double value);
 
   // Перегрузка методов
-  double& operator()(int row, int col) const;
+  const double& operator()(int row, int col) const;
+  // Отделяет общий блок даже при чтении, для чтения без копии - Get
   double& operator()(int row, int col);
+  // Указатель на первый элемент для внешнего кода, строки идут с шагом
+  // GetStride(). Запись через него возможна в любой момент, поэтому хеш
+  // больше не кешируется, а копии всегда полные. Действует до изменения
+  // размера, у перенесённой матрицы - nullptr
+  double* Data();
   S21Matrix operator+(const S21Matrix& other);
   S21Matrix operator-(const S21Matrix& other);
   S21Matrix operator*(double num);
-  S21Matrix operator*(const S21Matrix& other);
+  S21Matrix operator*(const S21Matrix& other) const;
   S21Matrix& operator=(S21Matrix&& other) noexcept;
   S21Matrix& operator=(const S21Matrix& other);
-  bool operator==(const S21Matrix& other);
+  bool operator==(const S21Matrix& other) const;
   S21Matrix& operator+=(const S21Matrix& other);
   S21Matrix& operator-=(const S21Matrix& other);
   S21Matrix& operator*=(const S21Matrix& other);
   S21Matrix& operator*=(double num);
   friend S21Matrix operator*(int scalar, const S21Matrix& matrix);
+  friend class S21MatrixTask;
+  friend class S21MatrixGraph;
+  friend class S21MatrixDecomposition;
+  friend class S21MatrixRandom;
+  friend class S21BandedMatrix;
+  friend class S21BlockDiagonalMatrix;
 
  private:
   int rows_;
   int cols_;
   double** matrix_;
+  // Блок данных со счётчиком ссылок, общий для копий в режиме COW
+  struct Block;
+  Block* block_;
 
-  void CreateMatrix();
+  // Начальное содержимое новой матрицы
+  enum class Init { kTwos, kUninitialized, kZeros };
+  S21Matrix(int rows, int cols, Init init);
+  // Забирает владение готовым блоком
+  S21Matrix(int rows, int cols, Block* block);
+  void CreateMatrix(Init init = Init::kTwos);
+  void Fill(double value);
   void RemoveMatrix();
+  static Block* NewBlock(int capacity, int stride, bool zeroed = false);
+  // С какого числа элементов заполнение и копирование идут параллельно:
+  // строки статически делятся между потоками пула, и страницы по
+  // возможности достаются узлам NUMA потоков, которые их первыми записали
+  static constexpr long kParallelSize = 1L << 16;
+  static void ForRows(int rows, int cols,
+                      const std::function<void(int, int)>& body);
+  // Переносит данные в новый блок, освобождая ссылку на старый
+  void Reallocate(int capacity, int stride);
+  // Вызывается перед записью: отделяет общий блок данных и увеличивает
+  // его версию, сбрасывая кеш хеша
+  void Detach();
+  // Хеш из кеша блока, если он вычислен для текущей версии
+  bool CachedHash(std::uint64_t& hash, bool& hasNan) const;
+  void CacheHash(std::uint64_t hash, bool hasNan) const;
+
+  // До этого размера определитель считается разложением по строке,
+  // для больших матриц - через LU-разложение с кешем
+  static constexpr int kCofactorSize = 3;
+  double UncachedDeterminant() const;
+
+  bool SameData(const S21Matrix& other) const;
+  template <typename Predicate>
+  bool CompareWith(const S21Matrix& other, Predicate same) const;
+
+  // Варианты долгих операций с поддержкой отмены и прогресса
+  S21Matrix Product(const S21Matrix& other, S21MatrixProgress* progress) const;
+  S21Matrix CalcComplements(S21MatrixProgress* progress) const;
+  S21Matrix InverseMatrix(S21MatrixProgress* progress) const;
+
+  // Умножение op(A) * op(B), где op - транспонирование или ничего
+  static S21Matrix Gemm(const S21Matrix& a, bool transA, const S21Matrix& b,
+                        bool transB, S21MatrixProgress* progress);
+  // Оптимальная расстановка скобок в цепочке умножений размеров
+  // dims[0] x dims[1], dims[1] x dims[2], ...; split[i][j] - точка разбиения
+  static std::vector<std::vector<int>> ChainOrder(const std::vector<int>& dims);
+  static std::size_t ChainScratch(const std::vector<int>& dims,
+                                  const std::vector<std::vector<int>>& split,
+                                  int i, int j);
+  static void MultiplyChain(const std::vector<const S21Matrix*>& factors,
+                            const std::vector<int>& dims,
+                            const std::vector<std::vector<int>>& split, int i,
+                            int j, double* out, double* scratch);
+  // C = A * B для блоков, лежащих по строкам с шагом lda и ldb
+  static void MulKernel(const double* a, int lda, const double* b, int ldb,
+                        double* c, int rows, int inner, int cols);
 };
 
 #endif
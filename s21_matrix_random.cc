@@ -0,0 +1,138 @@
+#include "s21_matrix_random.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "s21_matrix_decomposition.h"
+#include "s21_matrix_exception.h"
+
+S21MatrixRandom::S21MatrixRandom(std::uint64_t seed)
+    : seed_(seed), stream_(0) {}
+
+S21Matrix S21MatrixRandom::Uniform(int rows, int cols, double low,
+                                   double high) {
+  S21Matrix result = S21Matrix::Uninitialized(rows, cols);
+  std::uint64_t seed = seed_;
+  std::uint64_t stream = stream_++;
+  double** matrix = result.matrix_;
+  S21Matrix::ForRows(rows, cols, [=](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      std::uint64_t index = static_cast<std::uint64_t>(i) * cols;
+      for (int j = 0; j < cols; ++j) {
+        matrix[i][j] = low + (high - low) * Unit(seed, stream, index + j);
+      }
+    }
+  });
+  return result;
+}
+
+S21Matrix S21MatrixRandom::Gaussian(int rows, int cols, double mean,
+                                    double stddev) {
+  S21Matrix result = S21Matrix::Uninitialized(rows, cols);
+  std::uint64_t seed = seed_;
+  std::uint64_t stream = stream_++;
+  double** matrix = result.matrix_;
+  S21Matrix::ForRows(rows, cols, [=](int from, int to) {
+    const double pi = std::acos(-1.0);
+    for (int i = from; i < to; ++i) {
+      std::uint64_t index = 2 * static_cast<std::uint64_t>(i) * cols;
+      for (int j = 0; j < cols; ++j) {
+        // Преобразование Бокса - Мюллера, u1 берётся из (0, 1]
+        double u1 = 1.0 - Unit(seed, stream, index + 2 * j);
+        double u2 = Unit(seed, stream, index + 2 * j + 1);
+        double radius = std::sqrt(-2 * std::log(u1));
+        matrix[i][j] = mean + stddev * radius * std::cos(2 * pi * u2);
+      }
+    }
+  });
+  return result;
+}
+
+S21Matrix S21MatrixRandom::Orthogonal(int size) {
+  S21MatrixDecomposition::QR qr =
+      S21MatrixDecomposition::HouseholderQR(Gaussian(size, size));
+  // Знаки диагонали R фиксируются, иначе распределение Q не равномерно
+  for (int j = 0; j < size; ++j) {
+    if (qr.r.matrix_[j][j] < 0) {
+      for (int i = 0; i < size; ++i) qr.q.matrix_[i][j] = -qr.q.matrix_[i][j];
+    }
+  }
+  return qr.q;
+}
+
+S21Matrix S21MatrixRandom::Spd(int size, double condition) {
+  S21MatrixException::CheckCondition(condition);
+  S21Matrix q = Orthogonal(size);
+  S21Matrix result = Compose(q, Spectrum(size, condition), q);
+  // Округление нарушает симметрию в последних разрядах
+  for (int i = 0; i < size; ++i) {
+    for (int j = 0; j < i; ++j) {
+      double average = (result.matrix_[i][j] + result.matrix_[j][i]) / 2;
+      result.matrix_[i][j] = average;
+      result.matrix_[j][i] = average;
+    }
+  }
+  return result;
+}
+
+S21Matrix S21MatrixRandom::Banded(int rows, int cols, int lower, int upper) {
+  S21MatrixException::CheckBandwidth(lower, upper);
+  S21Matrix result = S21Matrix::Zeros(rows, cols);
+  std::uint64_t seed = seed_;
+  std::uint64_t stream = stream_++;
+  double** matrix = result.matrix_;
+  auto fill = [=](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      std::uint64_t index = static_cast<std::uint64_t>(i) * cols;
+      int last = std::min(cols - 1, i + upper);
+      for (int j = std::max(0, i - lower); j <= last; ++j) {
+        matrix[i][j] = 2 * Unit(seed, stream, index + j) - 1;
+      }
+    }
+  };
+  // Объём работы определяется шириной ленты, а не числом столбцов
+  S21Matrix::ForRows(rows, std::min(cols, lower + upper + 1), fill);
+  return result;
+}
+
+S21Matrix S21MatrixRandom::WithCondition(int size, double condition) {
+  S21MatrixException::CheckCondition(condition);
+  S21Matrix u = Orthogonal(size);
+  S21Matrix v = Orthogonal(size);
+  return Compose(u, Spectrum(size, condition), v);
+}
+
+double S21MatrixRandom::Unit(std::uint64_t seed, std::uint64_t stream,
+                             std::uint64_t index) {
+  std::uint64_t bits =
+      Mix(seed ^ Mix(stream * 0x9e3779b97f4a7c15ULL + Mix(index)));
+  // Старшие 53 бита дают равномерную сетку на [0, 1)
+  return static_cast<double>(bits >> 11) * 0x1.0p-53;
+}
+
+std::uint64_t S21MatrixRandom::Mix(std::uint64_t value) {
+  // Финализатор SplitMix64
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+std::vector<double> S21MatrixRandom::Spectrum(int size, double condition) {
+  std::vector<double> values(size, 1.0);
+  for (int i = 0; size > 1 && i < size; ++i) {
+    values[i] = std::pow(condition, 0.5 - static_cast<double>(i) / (size - 1));
+  }
+  return values;
+}
+
+S21Matrix S21MatrixRandom::Compose(const S21Matrix& u,
+                                   const std::vector<double>& values,
+                                   const S21Matrix& v) {
+  S21Matrix scaled(u);
+  scaled.Detach();
+  for (int i = 0; i < scaled.rows_; ++i) {
+    for (int j = 0; j < scaled.cols_; ++j) scaled.matrix_[i][j] *= values[j];
+  }
+  return S21Matrix::Gemm(scaled, false, v, true, nullptr);
+}
@@ -0,0 +1,47 @@
+#ifndef S21_MATRIX_RANDOM_H
+#define S21_MATRIX_RANDOM_H
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Генераторы случайных матриц. Каждый элемент - хеш от (seed, номер
+// вызова, номер элемента), поэтому результат воспроизводим и не зависит
+// от того, как строки поделены между потоками.
+class S21MatrixRandom {
+ public:
+  explicit S21MatrixRandom(std::uint64_t seed);
+
+  // Равномерно на [low, high)
+  S21Matrix Uniform(int rows, int cols, double low = -1, double high = 1);
+  S21Matrix Gaussian(int rows, int cols, double mean = 0, double stddev = 1);
+  // Ортогональная матрица, равномерно распределённая по группе O(n)
+  S21Matrix Orthogonal(int size);
+  // Симметричная положительно определённая матрица с числом
+  // обусловленности condition и определителем около единицы
+  S21Matrix Spd(int size, double condition = 10);
+  // Элементы вне lower поддиагоналей и upper наддиагоналей равны нулю
+  S21Matrix Banded(int rows, int cols, int lower, int upper);
+  // U * diag(sigma) * V^T с числом обусловленности condition
+  // и модулем определителя около единицы
+  S21Matrix WithCondition(int size, double condition);
+
+ private:
+  std::uint64_t seed_;
+  std::uint64_t stream_;
+
+  // Число с плавающей точкой на [0, 1) для элемента index текущего вызова
+  static double Unit(std::uint64_t seed, std::uint64_t stream,
+                     std::uint64_t index);
+  static std::uint64_t Mix(std::uint64_t value);
+  // Значения от sqrt(condition) до 1 / sqrt(condition), равномерные по
+  // логарифму, так что их произведение равно единице
+  static std::vector<double> Spectrum(int size, double condition);
+  // U * diag(values) * V^T
+  static S21Matrix Compose(const S21Matrix& u,
+                           const std::vector<double>& values,
+                           const S21Matrix& v);
+};
+
+#endif
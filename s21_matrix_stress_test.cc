@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix_async.h"
+#include "s21_matrix_banded.h"
+#include "s21_matrix_cache.h"
+#include "s21_matrix_decomposition.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_random.h"
+
+// Рандомизированное сравнение операций с эталонами на больших матрицах.
+// Собирается отдельно от обычных тестов: make stress, времена попадают в
+// отчёт gtest stress_report.xml. Размер и число раундов задаются
+// переменными окружения S21_STRESS_SIZE и S21_STRESS_ROUNDS, seed -
+// S21_STRESS_SEED.
+static int EnvValue(const char* name, int fallback) {
+  const char* value = std::getenv(name);
+  return value != nullptr ? std::atoi(value) : fallback;
+}
+
+static int StressSize() {
+  return std::max(4, EnvValue("S21_STRESS_SIZE", 256));
+}
+
+static int StressRounds() {
+  return std::max(1, EnvValue("S21_STRESS_ROUNDS", 2));
+}
+
+static int StressSeed() { return EnvValue("S21_STRESS_SEED", 2024); }
+
+// Выполняет body и записывает в отчёт gtest время в миллисекундах и
+// скорость. Номер раунда входит в ключ, чтобы раунды не затирали друг
+// друга в отчёте
+template <typename Body>
+static double Measure(const std::string& name, int round, double flops,
+                      Body body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  double ms = elapsed.count();
+  std::string key = name + " round " + std::to_string(round);
+  ::testing::Test::RecordProperty(key + " ms", std::to_string(ms));
+  if (flops > 0 && ms > 0) {
+    ::testing::Test::RecordProperty(key + " GFLOP/s",
+                                    std::to_string(flops / ms / 1e6));
+  }
+  return ms;
+}
+
+// Эталон: наивное умножение с накоплением в long double
+static S21Matrix ReferenceProduct(const S21Matrix& a, const S21Matrix& b) {
+  S21Matrix result = S21Matrix::Uninitialized(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < b.GetCols(); ++j) {
+      long double sum = 0;
+      for (int k = 0; k < a.GetCols(); ++k) {
+        sum += static_cast<long double>(a(i, k)) * b(k, j);
+      }
+      result(i, j) = static_cast<double>(sum);
+    }
+  }
+  return result;
+}
+
+static double MaxAbs(const S21Matrix& a) {
+  double result = 0;
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < a.GetCols(); ++j) {
+      result = std::max(result, std::abs(a(i, j)));
+    }
+  }
+  return result;
+}
+
+static double IdentityResidual(const S21Matrix& a, const S21Matrix& inverse) {
+  S21Matrix product = ReferenceProduct(a, inverse);
+  for (int i = 0; i < product.GetRows(); ++i) product(i, i) -= 1.0;
+  return MaxAbs(product);
+}
+
+static const double kEps = std::numeric_limits<double>::epsilon();
+// Предел числа строк ленточной системы, чтобы память под ленты, значения
+// и разложение не выходила за сотни мегабайт
+static const long kMaxBandedSize = 1L << 22;
+
+TEST(S21MatrixStressTests, MulMatrix) {
+  S21MatrixRandom random(StressSeed());
+  int n = StressSize();
+  for (int round = 0; round < StressRounds(); ++round) {
+    // Неквадратные размеры задевают хвосты строк
+    int m = std::max(1, n - 3 * round);
+    int k = n + 5;
+    S21Matrix a = random.Uniform(m, k);
+    S21Matrix b = random.Gaussian(k, n);
+    S21Matrix product(a);
+    Measure("MulMatrix " + std::to_string(m) + "x" + std::to_string(k) + "x" +
+                std::to_string(n),
+            round, 2.0 * m * k * n, [&product, &b] { product.MulMatrix(b); });
+    S21Matrix reference = ReferenceProduct(a, b);
+    double bound = 4 * k * kEps * MaxAbs(a) * MaxAbs(b);
+    EXPECT_TRUE(product.EqMatrix(reference, bound));
+
+    // Цепочка с другим порядком скобок сходится к тому же результату
+    S21Matrix c = random.Uniform(n, 7);
+    S21Matrix chain(1, 1);
+    Measure("MultiplyChain", round, 2.0 * k * n * 7 + 2.0 * m * k * 7,
+            [&chain, &a, &b, &c] {
+              chain = S21Matrix::MultiplyChain({&a, &b, &c});
+            });
+    S21Matrix direct = ReferenceProduct(reference, c);
+    EXPECT_TRUE(chain.EqMatrix(direct, 1e-10 * MaxAbs(direct)));
+  }
+}
+
+TEST(S21MatrixStressTests, Determinant) {
+  S21MatrixRandom random(StressSeed() + 1);
+  int n = StressSize();
+  for (int round = 0; round < StressRounds(); ++round) {
+    double condition = std::pow(10.0, 1 + round);
+    // Произведение сингулярных чисел генератора равно единице
+    S21Matrix a = random.WithCondition(n, condition);
+    double det = 0;
+    Measure("Determinant " + std::to_string(n), round, 2.0 / 3 * n * n * n,
+            [&det, &a] { det = a.Determinant(); });
+    EXPECT_NEAR(std::abs(det), 1.0, 1e3 * n * condition * kEps);
+
+    S21Matrix spd = random.Spd(n, condition);
+    EXPECT_NEAR(spd.Determinant(), 1.0, 1e3 * n * condition * kEps);
+
+    // det(A * B) = det(A) * det(B)
+    S21Matrix b = random.Spd(n, 2.0);
+    S21Matrix product = a * b;
+    EXPECT_NEAR(product.Determinant(), det * b.Determinant(),
+                1e3 * n * condition * kEps);
+  }
+}
+
+TEST(S21MatrixStressTests, InverseMatrix) {
+  S21MatrixRandom random(StressSeed() + 2);
+  int n = StressSize();
+  for (int round = 0; round < StressRounds(); ++round) {
+    double condition = std::pow(10.0, 2 + 2 * round);
+    S21Matrix a = round % 2 == 0 ? random.WithCondition(n, condition)
+                                 : random.Spd(n, condition);
+    S21Matrix inverse(1, 1);
+    Measure("InverseMatrix " + std::to_string(n), round, 2.0 * n * n * n,
+            [&inverse, &a] { inverse = a.InverseMatrix(); });
+    EXPECT_LT(IdentityResidual(a, inverse), 10.0 * n * condition * kEps);
+
+    // Повторное обращение из кеша даёт ту же матрицу
+    S21MatrixCache::Instance().Enable(64 << 20);
+    S21Matrix first = a.InverseMatrix();
+    S21Matrix cached(1, 1);
+    Measure("InverseMatrix cached", round, 0, [&cached, &a] {
+      cached = a.InverseMatrix();
+    });
+    S21MatrixCache::Instance().Clear();
+    S21MatrixCache::Instance().Disable();
+    EXPECT_TRUE(first == inverse);
+    EXPECT_TRUE(cached == inverse);
+
+    S21Matrix twice = inverse.InverseMatrix();
+    EXPECT_TRUE(twice.EqMatrix(a, 10.0 * n * condition * kEps * MaxAbs(a)));
+  }
+}
+
+TEST(S21MatrixStressTests, Decompositions) {
+  S21MatrixRandom random(StressSeed() + 6);
+  int n = StressSize();
+  for (int round = 0; round < StressRounds(); ++round) {
+    S21Matrix a = random.Gaussian(n, n / 2 + round);
+    int k = a.GetCols();
+    S21MatrixDecomposition::QR qr = S21MatrixDecomposition::HouseholderQR(a);
+    Measure("HouseholderQR " + std::to_string(n) + "x" + std::to_string(k),
+            round, 4.0 * n * k * k - 4.0 / 3 * k * k * k, [&qr, &a] {
+              qr = S21MatrixDecomposition::HouseholderQR(a);
+            });
+    EXPECT_TRUE((qr.q * qr.r).EqMatrix(a, 1e2 * n * kEps * MaxAbs(a)));
+
+    double condition = std::pow(10.0, 1 + round);
+    S21Matrix spd = random.Spd(n, condition);
+    S21MatrixDecomposition::Eigen eigen =
+        S21MatrixDecomposition::SymmetricEigen(spd);
+    Measure("SymmetricEigen " + std::to_string(n), round, 9.0 * n * n * n,
+            [&eigen, &spd] {
+              eigen = S21MatrixDecomposition::SymmetricEigen(spd);
+            });
+    // Собственные числа генератора лежат в [1 / sqrt(c), sqrt(c)]
+    double bound = 1e2 * n * kEps * std::sqrt(condition);
+    EXPECT_NEAR(eigen.values(0, 0), 1 / std::sqrt(condition), bound);
+    EXPECT_NEAR(eigen.values(n - 1, 0), std::sqrt(condition), bound);
+
+    // Якоби сходится за десяток проходов по n^2 / 2 парам
+    int m = std::max(2, n / 2);
+    S21Matrix b = random.WithCondition(m, condition);
+    S21MatrixDecomposition::SVD svd = S21MatrixDecomposition::JacobiSVD(b);
+    Measure("JacobiSVD " + std::to_string(m), round, 10 * 4.0 * m * m * m,
+            [&svd, &b] { svd = S21MatrixDecomposition::JacobiSVD(b); });
+    EXPECT_NEAR(svd.sigma(0, 0) / svd.sigma(m - 1, 0), condition,
+                1e2 * m * kEps * condition * condition);
+  }
+}
+
+TEST(S21MatrixStressTests, Concurrency) {
+  S21MatrixRandom random(StressSeed() + 3);
+  int n = std::max(4, StressSize() / 2);
+  S21Matrix a = random.WithCondition(n, 100.0);
+  S21Matrix b = random.Uniform(n, n);
+  S21Matrix product = a * b;
+  S21Matrix inverse = a.InverseMatrix();
+  double det = a.Determinant();
+
+  // Потоки читают общие входы, результаты должны совпасть побитово
+  std::vector<int> mismatches(4, 0);
+  std::vector<std::thread> threads;
+  Measure("Concurrent mul/inverse x4", 0, 4 * 4.0 * n * n * n, [&] {
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t] {
+        for (int round = 0; round < StressRounds(); ++round) {
+          S21Matrix left(a);
+          left.MulMatrix(b);
+          if (!(left == product)) mismatches[t]++;
+          if (!(a.InverseMatrix() == inverse)) mismatches[t]++;
+          if (a.Determinant() != det) mismatches[t]++;
+        }
+      });
+    }
+    for (std::thread& thread : threads) thread.join();
+  });
+  for (int count : mismatches) EXPECT_EQ(count, 0);
+
+  std::vector<S21MatrixTask> tasks;
+  Measure("Async tasks x8", 0, 8 * 2.0 * n * n * n, [&] {
+    for (int t = 0; t < 8; ++t) {
+      tasks.push_back(t % 2 == 0 ? a.MulMatrixAsync(b)
+                                 : a.InverseMatrixAsync());
+    }
+    for (S21MatrixTask& task : tasks) task.Wait();
+  });
+  for (int t = 0; t < 8; ++t) {
+    EXPECT_TRUE(tasks[t].Get() == (t % 2 == 0 ? product : inverse));
+  }
+}
+
+TEST(S21MatrixStressTests, BandedProduct) {
+  S21MatrixRandom random(StressSeed() + 4);
+  int n = StressSize();
+  S21Matrix a = random.Banded(n, n, 2, 1);
+  S21Matrix b = random.Banded(n, n, 1, 3);
+  S21Matrix product = a * b;
+  // Ширины лент складываются
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      if (j < i - 3 || j > i + 4) {
+        EXPECT_EQ(product(i, j), 0.0);
+      }
+    }
+  }
+  EXPECT_TRUE(product.EqMatrix(ReferenceProduct(a, b), 1e-14));
+}
+
+TEST(S21MatrixStressTests, BandedSolve) {
+  // Пятидиагональная система на размере, недоступном плотной матрице
+  S21MatrixRandom random(StressSeed() + 5);
+  int n = static_cast<int>(std::min(4000L * StressSize(), kMaxBandedSize));
+  S21BandedMatrix a(n, 2, 2);
+  S21Matrix values = random.Uniform(n, 5);
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - 2); j <= std::min(n - 1, i + 2); ++j) {
+      a(i, j) = values(i, j - i + 2);
+    }
+  }
+  std::vector<double> rhs(n, 1.0);
+  S21BandedMatrix::LU lu = a.Factorize();
+  Measure("Banded LU " + std::to_string(n), 0, 2.0 * n * 2 * 6,
+          [&lu, &a] { lu = a.Factorize(); });
+  std::vector<double> x;
+  Measure("Banded solve", 0, 2.0 * n * 8, [&x, &lu, &rhs] {
+    x = S21BandedMatrix::Solve(lu, rhs);
+  });
+  std::vector<double> check = a.Multiply(x);
+  double scale = 0;
+  double residual = 0;
+  for (int i = 0; i < n; ++i) {
+    scale = std::max(scale, std::abs(x[i]));
+    residual = std::max(residual, std::abs(check[i] - rhs[i]));
+  }
+  EXPECT_LT(residual, 1e3 * kEps * std::max(1.0, scale));
+}
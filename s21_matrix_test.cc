@@ -1,6 +1,23 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix_async.h"
+#include "s21_matrix_banded.h"
+#include "s21_matrix_block_diagonal.h"
+#include "s21_matrix_c.h"
+#include "s21_matrix_cache.h"
+#include "s21_matrix_decomposition.h"
 #include "s21_matrix_exception.h"
+#include "s21_matrix_executor.h"
+#include "s21_matrix_graph.h"
+#include "s21_matrix_numa.h"
+#include "s21_matrix_random.h"
 #include "s21_matrix_oop.h"
 
 // Тесты для GetRows и GetCols
@@ -71,6 +88,9 @@ TEST(S21MatrixTest, MoveConstructor) {
   // Проверка, что размеры перемещенной матрицы совпадают с исходными
   EXPECT_EQ(movedMatrix.GetRows(), originalRows);
   EXPECT_EQ(movedMatrix.GetCols(), originalCols);
+  // Перенесённая матрица пуста, изменение её размера - ошибка
+  EXPECT_THROW(originalMatrix.SetRows(3), std::invalid_argument);
+  EXPECT_THROW(originalMatrix.SetCols(3), std::invalid_argument);
 }
 
 TEST(S21MatrixTest, CopyConstructor) {
@@ -566,4 +586,1271 @@ TEST(S21MatrixOperatorTests, EqualityOperator) {
 
   // Проверяем неравенство двух разных матриц
   EXPECT_FALSE(matrix1 == matrix3);
-}
\ No newline at end of file
+}
+
+// Тесты для асинхронных операций
+TEST(S21MatrixAsyncTests, MulMatrixAsync) {
+  S21Matrix matrix1(2, 3);
+  S21Matrix matrix2(3, 2);
+  matrix1(0, 0) = 1.0;
+  matrix1(1, 2) = 6.0;
+  matrix2(2, 1) = 12.0;
+
+  S21MatrixTask task = matrix1.MulMatrixAsync(matrix2);
+  S21Matrix expected = matrix1 * matrix2;
+
+  EXPECT_TRUE(task.Get() == expected);
+  EXPECT_TRUE(task.IsReady());
+  EXPECT_DOUBLE_EQ(task.GetProgress(), 1.0);
+}
+
+TEST(S21MatrixAsyncTests, InverseMatrixAsync) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 4.0;
+  matrix(0, 1) = 3.0;
+  matrix(1, 0) = 3.0;
+  matrix(1, 1) = 2.0;
+
+  S21Matrix inverse = matrix.InverseMatrixAsync().Get();
+
+  EXPECT_DOUBLE_EQ(inverse(0, 0), -2.0);
+  EXPECT_DOUBLE_EQ(inverse(0, 1), 3.0);
+  EXPECT_DOUBLE_EQ(inverse(1, 0), 3.0);
+  EXPECT_DOUBLE_EQ(inverse(1, 1), -4.0);
+}
+
+TEST(S21MatrixAsyncTests, DependencyChain) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = 4.0;
+  matrix(0, 1) = 3.0;
+  matrix(1, 0) = 3.0;
+  matrix(1, 1) = 2.0;
+
+  // (A^-1 * A)^T + A
+  S21MatrixTask a = S21MatrixTask::Ready(matrix);
+  S21MatrixTask inverse = S21MatrixTask::Inverse(a);
+  S21MatrixTask identity = S21MatrixTask::Mul(inverse, a);
+  S21MatrixTask result =
+      S21MatrixTask::Sum(S21MatrixTask::Transpose(identity), a);
+
+  S21Matrix value = result.Get();
+  EXPECT_DOUBLE_EQ(value(0, 0), 5.0);
+  EXPECT_DOUBLE_EQ(value(0, 1), 3.0);
+  EXPECT_DOUBLE_EQ(value(1, 0), 3.0);
+  EXPECT_DOUBLE_EQ(value(1, 1), 3.0);
+  // Операции без отчётов о прогрессе тоже завершаются с прогрессом 1
+  EXPECT_DOUBLE_EQ(result.GetProgress(), 1.0);
+  S21MatrixTask sum = S21MatrixTask::Sum(a, a);
+  sum.Wait();
+  EXPECT_DOUBLE_EQ(sum.GetProgress(), 1.0);
+  // Обратная матрица из кеша тоже не сообщает о прогрессе
+  S21MatrixTask cached = S21MatrixTask::Inverse(a);
+  cached.Wait();
+  EXPECT_DOUBLE_EQ(cached.GetProgress(), 1.0);
+}
+
+TEST(S21MatrixAsyncTests, ErrorPropagation) {
+  S21Matrix matrix1(2, 2);
+  S21Matrix matrix2(3, 3);
+
+  S21MatrixTask product = matrix1.MulMatrixAsync(matrix2);
+  S21MatrixTask dependent = S21MatrixTask::MulNumber(product, 2.0);
+
+  EXPECT_THROW(product.Get(), std::invalid_argument);
+  EXPECT_THROW(dependent.Get(), std::invalid_argument);
+}
+
+TEST(S21MatrixAsyncTests, Cancel) {
+  S21Matrix matrix(400, 400);
+
+  // Зависимая задача не может стартовать раньше долгого умножения
+  S21MatrixTask square = matrix.MulMatrixAsync(matrix);
+  S21MatrixTask product = S21MatrixTask::Mul(square, square);
+  product.Cancel();
+
+  EXPECT_TRUE(product.IsCancelled());
+  EXPECT_THROW(product.Get(), std::runtime_error);
+  EXPECT_NO_THROW(square.Get());
+}
+
+// Тесты для графа отложенных вычислений
+static S21Matrix MakeSequence(int rows, int cols, double start) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix.Set(i, j, start + i * cols + j);
+    }
+  }
+  return matrix;
+}
+
+TEST(S21MatrixGraphTests, CommonSubexpressions) {
+  S21Matrix matrix = MakeSequence(3, 2, 1.0);
+  S21MatrixGraph graph;
+  S21MatrixExpr a = graph.Input(matrix);
+
+  S21MatrixExpr first = a.Transpose() * a;
+  int nodes = graph.GetNodeCount();
+  S21MatrixExpr second = a.Transpose() * graph.Input(matrix);
+  EXPECT_EQ(graph.GetNodeCount(), nodes);
+
+  S21Matrix result = (first + second).Evaluate();
+  S21Matrix expected = matrix.Transpose() * matrix;
+  expected *= 2.0;
+  EXPECT_TRUE(result == expected);
+
+  S21MatrixGraph::Stats stats = graph.GetStats();
+  EXPECT_EQ(stats.multiplications, 1);
+  EXPECT_EQ(stats.transposes, 0);
+}
+
+TEST(S21MatrixGraphTests, ChainReassociation) {
+  S21Matrix a = MakeSequence(10, 100, 1.0);
+  S21Matrix b = MakeSequence(100, 5, 2.0);
+  S21Matrix c = MakeSequence(5, 50, 3.0);
+  S21MatrixGraph graph;
+
+  S21MatrixExpr expr = graph.Input(a) * graph.Input(b) * graph.Input(c);
+  S21Matrix result = expr.Evaluate();
+  S21Matrix expected = (a * b) * c;
+
+  EXPECT_TRUE(result == expected);
+  EXPECT_EQ(graph.GetStats().flops, 10LL * 100 * 5 + 10LL * 5 * 50);
+
+  // Правая скобка дороже, граф должен вернуться к (A * B) * C
+  S21MatrixExpr rightFirst =
+      graph.Input(a) * (graph.Input(b) * graph.Input(c));
+  EXPECT_TRUE(rightFirst.Evaluate() == expected);
+  EXPECT_EQ(graph.GetStats().flops, 10LL * 100 * 5 + 10LL * 5 * 50);
+}
+
+TEST(S21MatrixGraphTests, FusedElementwise) {
+  S21Matrix a = MakeSequence(2, 3, 1.0);
+  S21Matrix b = MakeSequence(3, 2, -4.0);
+  S21MatrixGraph graph;
+
+  S21MatrixExpr expr =
+      (graph.Input(a) * 2.0 - graph.Input(b).Transpose()) + graph.Input(a);
+  S21Matrix result = expr.Evaluate();
+  S21Matrix expected = a * 3.0 - b.Transpose();
+
+  EXPECT_TRUE(result == expected);
+  EXPECT_EQ(graph.GetStats().fusedPasses, 1);
+  EXPECT_EQ(graph.GetStats().transposes, 0);
+}
+
+TEST(S21MatrixGraphTests, TransposedProduct) {
+  S21Matrix a = MakeSequence(4, 3, 1.0);
+  S21Matrix b = MakeSequence(2, 3, 5.0);
+  S21MatrixGraph graph;
+
+  S21MatrixExpr expr = graph.Input(a) * graph.Input(b).Transpose();
+  S21Matrix result = expr.Evaluate();
+
+  EXPECT_TRUE(result == a * b.Transpose());
+  EXPECT_EQ(graph.GetStats().transposes, 0);
+  EXPECT_TRUE(expr.Transpose().Transpose().Evaluate() == result);
+}
+
+TEST(S21MatrixGraphTests, InvalidShapes) {
+  S21Matrix a(2, 3);
+  S21Matrix b(2, 2);
+  S21MatrixGraph graph;
+
+  EXPECT_THROW(graph.Input(a) * graph.Input(b), std::invalid_argument);
+  EXPECT_THROW(graph.Input(a) + graph.Input(b), std::invalid_argument);
+}
+
+TEST(S21MatrixGraphTests, ForeignExpressions) {
+  S21Matrix a(2, 2);
+  S21MatrixGraph graph;
+  S21MatrixGraph other;
+  S21MatrixExpr x = graph.Input(a);
+  S21MatrixExpr y = other.Input(a);
+
+  EXPECT_THROW(x + y, std::invalid_argument);
+  EXPECT_THROW(x - y, std::invalid_argument);
+  EXPECT_THROW(x * y, std::invalid_argument);
+  EXPECT_THROW(other.Evaluate(x * 2.0), std::invalid_argument);
+  EXPECT_TRUE(graph.Evaluate(x + x) == a * 2.0);
+}
+
+TEST(S21MatrixGraphTests, NanScalar) {
+  S21Matrix a = MakeSequence(2, 2, 1.0);
+  S21MatrixGraph graph;
+  S21MatrixExpr x = graph.Input(a);
+  double nan = std::numeric_limits<double>::quiet_NaN();
+
+  S21MatrixExpr first = x * nan;
+  int nodes = graph.GetNodeCount();
+  S21MatrixExpr second = x * nan;
+  EXPECT_EQ(graph.GetNodeCount(), nodes);
+  EXPECT_TRUE(std::isnan((first + second).Evaluate()(0, 0)));
+  EXPECT_TRUE((x * 2.0).Evaluate() == a * 2.0);
+}
+
+TEST(S21MatrixGraphTests, ResizedInput) {
+  S21Matrix a = MakeSequence(2, 2, 1.0);
+  S21MatrixGraph graph;
+  S21MatrixExpr x = graph.Input(a);
+  S21MatrixExpr expr = x * x;
+
+  a.SetRows(1);
+  EXPECT_THROW(expr.Evaluate(), std::invalid_argument);
+  a.SetRows(2);
+  EXPECT_NO_THROW(expr.Evaluate());
+}
+
+// Тесты для произведения цепочки матриц
+TEST(S21MatrixTest, MultiplyChain) {
+  S21Matrix a = MakeSequence(3, 10, 1.0);
+  S21Matrix b = MakeSequence(10, 2, -3.0);
+  S21Matrix c = MakeSequence(2, 8, 0.5);
+  S21Matrix d = MakeSequence(8, 4, 2.0);
+
+  S21Matrix result = S21Matrix::MultiplyChain({&a, &b, &c, &d});
+  S21Matrix expected = ((a * b) * c) * d;
+
+  EXPECT_EQ(result.GetRows(), 3);
+  EXPECT_EQ(result.GetCols(), 4);
+  EXPECT_TRUE(result == expected);
+}
+
+TEST(S21MatrixTest, MultiplyChainNested) {
+  // Оптимальный порядок (A * B) * (C * D) держит два буфера одновременно
+  S21Matrix a = MakeSequence(2, 9, 1.0);
+  S21Matrix b = MakeSequence(9, 2, 1.0);
+  S21Matrix c = MakeSequence(2, 9, 1.0);
+  S21Matrix d = MakeSequence(9, 2, 1.0);
+
+  S21Matrix result = S21Matrix::MultiplyChain({&a, &b, &c, &d});
+
+  EXPECT_TRUE(result == (a * b) * (c * d));
+}
+
+TEST(S21MatrixTest, MultiplyChainSingle) {
+  S21Matrix a = MakeSequence(2, 3, 1.0);
+
+  EXPECT_TRUE(S21Matrix::MultiplyChain({&a}) == a);
+}
+
+TEST(S21MatrixTest, MultiplyChainInvalid) {
+  S21Matrix a(2, 3);
+  S21Matrix b(2, 3);
+
+  EXPECT_THROW(S21Matrix::MultiplyChain({&a, &b}), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::MultiplyChain({}), std::invalid_argument);
+}
+
+// Тесты для режима копирования при записи
+TEST(S21MatrixCowTests, CopySharesUntilWrite) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix original = MakeSequence(3, 3, 1.0);
+  S21Matrix copy(original);
+  S21Matrix assigned;
+  assigned = original;
+
+  EXPECT_TRUE(original.IsShared());
+  EXPECT_TRUE(copy.IsShared());
+
+  copy(0, 0) = 100.0;
+  assigned.MulNumber(2.0);
+  S21Matrix::SetCopyOnWrite(false);
+
+  EXPECT_FALSE(copy.IsShared());
+  EXPECT_FALSE(assigned.IsShared());
+  EXPECT_DOUBLE_EQ(original(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(copy(0, 0), 100.0);
+  EXPECT_DOUBLE_EQ(assigned(0, 0), 2.0);
+  EXPECT_DOUBLE_EQ(copy(2, 2), original(2, 2));
+}
+
+TEST(S21MatrixCowTests, LiveReferenceForcesCopy) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix original = MakeSequence(2, 2, 1.0);
+  double& element = original(0, 0);
+  S21Matrix copy(original);
+  element = 42.0;
+  S21Matrix::SetCopyOnWrite(false);
+
+  EXPECT_FALSE(copy.IsShared());
+  EXPECT_DOUBLE_EQ(copy(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(original(0, 0), 42.0);
+}
+
+TEST(S21MatrixCowTests, GetAndSet) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix original = MakeSequence(2, 2, 1.0);
+  S21Matrix copy(original);
+  double value = copy.Get(1, 1);
+  bool sharedAfterRead = copy.IsShared();
+  copy.Set(0, 0, 10.0);
+  S21Matrix second(copy);
+  S21Matrix::SetCopyOnWrite(false);
+
+  EXPECT_DOUBLE_EQ(value, 4.0);
+  EXPECT_TRUE(sharedAfterRead);
+  EXPECT_TRUE(second.IsShared());
+  EXPECT_DOUBLE_EQ(original.Get(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(second.Get(0, 0), 10.0);
+  EXPECT_THROW(copy.Get(2, 0), std::out_of_range);
+  EXPECT_THROW(copy.Set(0, -1, 1.0), std::out_of_range);
+}
+
+TEST(S21MatrixCowTests, ResizeDetaches) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix original = MakeSequence(2, 2, 1.0);
+  S21Matrix rows(original);
+  S21Matrix cols(original);
+  S21Matrix appended(original);
+  rows.SetRows(5);
+  cols.SetCols(3);
+  appended.AppendRow({5, 6});
+  S21Matrix::SetCopyOnWrite(false);
+
+  EXPECT_FALSE(original.IsShared());
+  EXPECT_TRUE(original == MakeSequence(2, 2, 1.0));
+  EXPECT_DOUBLE_EQ(rows.Get(1, 1), 4.0);
+  EXPECT_DOUBLE_EQ(rows.Get(4, 1), 0.0);
+  EXPECT_DOUBLE_EQ(cols.Get(1, 2), 0.0);
+  EXPECT_DOUBLE_EQ(appended.Get(2, 1), 6.0);
+}
+
+TEST(S21MatrixCowTests, InPlaceOperationsDetach) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix original = MakeSequence(2, 2, 1.0);
+  S21Matrix sum(original);
+  S21Matrix sub(original);
+  S21Matrix product(original);
+  sum += original;
+  sub -= original;
+  product *= original;
+  S21Matrix::SetCopyOnWrite(false);
+
+  EXPECT_FALSE(original.IsShared());
+  EXPECT_DOUBLE_EQ(original(1, 1), 4.0);
+  EXPECT_DOUBLE_EQ(sum(1, 1), 8.0);
+  EXPECT_DOUBLE_EQ(sub(1, 1), 0.0);
+  EXPECT_DOUBLE_EQ(product(1, 1), 22.0);
+}
+
+TEST(S21MatrixCowTests, DisabledByDefault) {
+  S21Matrix original(2, 2);
+  S21Matrix copy(original);
+
+  EXPECT_FALSE(S21Matrix::IsCopyOnWrite());
+  EXPECT_FALSE(original.IsShared());
+}
+
+TEST(S21MatrixCowTests, ConcurrentReaders) {
+  S21Matrix::SetCopyOnWrite(true);
+  const S21Matrix original = MakeSequence(16, 16, 0.0);
+  std::vector<double> sums(4, 0.0);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&original, &sums, t] {
+      for (int n = 0; n < 100; ++n) {
+        S21Matrix copy(original);
+        sums[t] += copy.GetRows() == 16 ? original(15, 15) : 0.0;
+      }
+    });
+  }
+  for (std::thread& reader : readers) reader.join();
+  S21Matrix::SetCopyOnWrite(false);
+
+  EXPECT_FALSE(original.IsShared());
+  for (double sum : sums) EXPECT_DOUBLE_EQ(sum, 25500.0);
+}
+
+// Тесты для запаса памяти и добавления строк
+TEST(S21MatrixTest, AppendRow) {
+  S21Matrix matrix(1, 3);
+  for (int i = 1; i < 100; ++i) {
+    matrix.AppendRow({1.0 * i, 2.0 * i, 3.0 * i});
+  }
+
+  EXPECT_EQ(matrix.GetRows(), 100);
+  EXPECT_GE(matrix.GetCapacity(), 100);
+  EXPECT_LT(matrix.GetCapacity(), 200);
+  EXPECT_DOUBLE_EQ(matrix(0, 0), 2.0);
+  EXPECT_DOUBLE_EQ(matrix(99, 2), 297.0);
+  EXPECT_THROW(matrix.AppendRow({1.0}), std::invalid_argument);
+
+  matrix.ShrinkToFit();
+  EXPECT_EQ(matrix.GetCapacity(), 100);
+  EXPECT_DOUBLE_EQ(matrix(50, 1), 100.0);
+}
+
+TEST(S21MatrixTest, ReserveKeepsValues) {
+  S21Matrix matrix = MakeSequence(2, 2, 1.0);
+  matrix.Reserve(10, 4);
+  EXPECT_EQ(matrix.GetCapacity(), 10);
+
+  matrix.SetCols(4);
+  matrix.SetRows(3);
+  EXPECT_EQ(matrix.GetCapacity(), 10);
+  EXPECT_DOUBLE_EQ(matrix(1, 1), 4.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 3), 0.0);
+  EXPECT_DOUBLE_EQ(matrix(2, 0), 0.0);
+}
+
+TEST(S21MatrixTest, ResizeInPlace) {
+  S21Matrix matrix = MakeSequence(4, 4, 1.0);
+  matrix.SetRows(2);
+  matrix.SetCols(2);
+  EXPECT_EQ(matrix.GetCapacity(), 4);
+
+  // Обрезанные элементы не должны вернуться после роста
+  matrix.SetRows(3);
+  matrix.SetCols(3);
+  EXPECT_EQ(matrix.GetCapacity(), 4);
+  EXPECT_DOUBLE_EQ(matrix(1, 1), 6.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 2), 0.0);
+  EXPECT_DOUBLE_EQ(matrix(2, 2), 0.0);
+
+  S21Matrix copy(matrix);
+  EXPECT_TRUE(copy == matrix);
+  EXPECT_TRUE(S21Matrix::MultiplyChain({&matrix, &copy}) == matrix * copy);
+}
+
+// Тесты для разложений
+static double MaxDifference(const S21Matrix& a, const S21Matrix& b) {
+  double result = 0;
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < a.GetCols(); ++j) {
+      result = std::max(result, std::abs(a(i, j) - b(i, j)));
+    }
+  }
+  return result;
+}
+
+static S21Matrix Diagonal(const S21Matrix& values) {
+  S21Matrix result(values.GetRows(), values.GetRows());
+  for (int i = 0; i < values.GetRows(); ++i) {
+    for (int j = 0; j < values.GetRows(); ++j) {
+      result(i, j) = i == j ? values(i, 0) : 0.0;
+    }
+  }
+  return result;
+}
+
+static S21Matrix Pseudorandom(int rows, int cols, int seed) {
+  S21Matrix matrix(rows, cols);
+  unsigned state = 12345u + seed;
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      state = state * 1103515245u + 12345u;
+      matrix(i, j) = static_cast<double>((state >> 8) % 2001) / 1000.0 - 1.0;
+    }
+  }
+  return matrix;
+}
+
+TEST(S21MatrixDecompositionTests, HouseholderQR) {
+  for (S21Matrix a : {Pseudorandom(7, 4, 1), Pseudorandom(4, 6, 2),
+                      Pseudorandom(5, 5, 3)}) {
+    S21MatrixDecomposition::QR qr = S21MatrixDecomposition::HouseholderQR(a);
+    int k = std::min(a.GetRows(), a.GetCols());
+
+    EXPECT_EQ(qr.q.GetCols(), k);
+    EXPECT_EQ(qr.r.GetRows(), k);
+    EXPECT_LT(MaxDifference(qr.q * qr.r, a), 1e-12);
+    EXPECT_LT(MaxDifference(qr.q.Transpose() * qr.q, S21Matrix::Identity(k)),
+              1e-12);
+    for (int i = 0; i < k; ++i) {
+      for (int j = 0; j < i; ++j) EXPECT_DOUBLE_EQ(qr.r(i, j), 0.0);
+    }
+  }
+}
+
+TEST(S21MatrixDecompositionTests, HouseholderQRParallel) {
+  // Несколько панелей блочного QR и параллельное обновление остатка
+  S21Matrix a = Pseudorandom(300, 260, 4);
+  S21MatrixDecomposition::QR qr = S21MatrixDecomposition::HouseholderQR(a);
+
+  EXPECT_LT(MaxDifference(qr.q * qr.r, a), 1e-11);
+  EXPECT_LT(MaxDifference(qr.q.Transpose() * qr.q, S21Matrix::Identity(260)),
+            1e-12);
+  EXPECT_DOUBLE_EQ(qr.r(259, 200), 0.0);
+}
+
+TEST(S21MatrixDecompositionTests, SymmetricEigen) {
+  S21Matrix b = Pseudorandom(6, 6, 5);
+  S21Matrix a = b + b.Transpose();
+  S21MatrixDecomposition::Eigen eigen =
+      S21MatrixDecomposition::SymmetricEigen(a);
+
+  S21Matrix restored =
+      eigen.vectors * Diagonal(eigen.values) * eigen.vectors.Transpose();
+  EXPECT_LT(MaxDifference(restored, a), 1e-12);
+  EXPECT_LT(MaxDifference(eigen.vectors.Transpose() * eigen.vectors,
+                          S21Matrix::Identity(6)),
+            1e-12);
+  for (int i = 1; i < 6; ++i) {
+    EXPECT_LE(eigen.values(i - 1, 0), eigen.values(i, 0));
+  }
+}
+
+TEST(S21MatrixDecompositionTests, SymmetricEigenParallel) {
+  // Обновления и вращения большой матрицы идут через пул потоков
+  S21Matrix b = Pseudorandom(300, 300, 8);
+  S21Matrix a = b + b.Transpose();
+  S21MatrixDecomposition::Eigen eigen =
+      S21MatrixDecomposition::SymmetricEigen(a);
+
+  EXPECT_LT(MaxDifference(a * eigen.vectors,
+                          eigen.vectors * Diagonal(eigen.values)),
+            1e-10);
+  EXPECT_LT(MaxDifference(eigen.vectors.Transpose() * eigen.vectors,
+                          S21Matrix::Identity(300)),
+            1e-12);
+}
+
+TEST(S21MatrixDecompositionTests, SymmetricEigenKnown) {
+  S21Matrix a(2, 2);
+  a(0, 0) = 2.0;
+  a(0, 1) = 1.0;
+  a(1, 0) = 1.0;
+  a(1, 1) = 2.0;
+  S21MatrixDecomposition::Eigen eigen =
+      S21MatrixDecomposition::SymmetricEigen(a);
+
+  EXPECT_NEAR(eigen.values(0, 0), 1.0, 1e-14);
+  EXPECT_NEAR(eigen.values(1, 0), 3.0, 1e-14);
+
+  // Асимметрия на уровне округления допустима
+  a(0, 1) = std::nextafter(1.0, 2.0);
+  EXPECT_NO_THROW(S21MatrixDecomposition::SymmetricEigen(a));
+  a(0, 1) = 5.0;
+  EXPECT_THROW(S21MatrixDecomposition::SymmetricEigen(a),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixDecompositionTests, JacobiSVD) {
+  for (S21Matrix a : {Pseudorandom(6, 4, 6), Pseudorandom(3, 7, 7)}) {
+    S21MatrixDecomposition::SVD svd = S21MatrixDecomposition::JacobiSVD(a);
+    int k = std::min(a.GetRows(), a.GetCols());
+
+    EXPECT_EQ(svd.sigma.GetRows(), k);
+    S21Matrix restored = svd.u * Diagonal(svd.sigma) * svd.v.Transpose();
+    EXPECT_LT(MaxDifference(restored, a), 1e-12);
+    EXPECT_LT(MaxDifference(svd.u.Transpose() * svd.u, S21Matrix::Identity(k)),
+              1e-12);
+    EXPECT_LT(MaxDifference(svd.v.Transpose() * svd.v, S21Matrix::Identity(k)),
+              1e-12);
+    for (int i = 1; i < k; ++i) {
+      EXPECT_GE(svd.sigma(i - 1, 0), svd.sigma(i, 0));
+    }
+  }
+}
+
+TEST(S21MatrixDecompositionTests, JacobiSVDRankDeficient) {
+  S21Matrix a = Pseudorandom(5, 3, 9);
+  for (int i = 0; i < 5; ++i) a(i, 2) = a(i, 0) + a(i, 1);
+  for (S21Matrix matrix : {a, a.Transpose(), S21Matrix::Zeros(3, 3)}) {
+    S21MatrixDecomposition::SVD svd =
+        S21MatrixDecomposition::JacobiSVD(matrix);
+    S21Matrix restored = svd.u * Diagonal(svd.sigma) * svd.v.Transpose();
+
+    EXPECT_LT(MaxDifference(restored, matrix), 1e-12);
+    EXPECT_LT(MaxDifference(svd.u.Transpose() * svd.u, S21Matrix::Identity(3)),
+              1e-12);
+    EXPECT_LT(svd.sigma(2, 0), 1e-12);
+  }
+}
+
+TEST(S21MatrixDecompositionTests, JacobiSVDNotConverged) {
+  S21Matrix a = Pseudorandom(4, 3, 10);
+  a(1, 1) = NAN;
+
+  EXPECT_THROW(S21MatrixDecomposition::JacobiSVD(a), std::runtime_error);
+}
+
+TEST(S21MatrixExecutorTests, ParallelFor) {
+  S21MatrixExecutor executor(4);
+  std::vector<int> marks(1000, 0);
+  std::atomic<int> calls(0);
+
+  executor.ParallelFor(0, 1000, [&marks, &calls](int from, int to) {
+    calls++;
+    for (int i = from; i < to; ++i) marks[i]++;
+  });
+
+  EXPECT_GT(calls.load(), 1);
+  for (int mark : marks) EXPECT_EQ(mark, 1);
+  EXPECT_THROW(executor.ParallelFor(0, 10,
+                                    [](int, int) {
+                                      throw std::runtime_error("failure");
+                                    }),
+               std::runtime_error);
+}
+
+TEST(S21MatrixExecutorTests, ParallelForStatic) {
+  S21MatrixExecutor executor(4);
+  std::vector<std::thread::id> first(4);
+  std::vector<std::thread::id> second(4);
+  std::vector<int> marks(1000, 0);
+
+  // Одинаковые части достаются одним и тем же потокам
+  for (std::vector<std::thread::id>* owners : {&first, &second}) {
+    executor.ParallelForStatic(0, 1000, [owners, &marks](int from, int to) {
+      (*owners)[from / 250] = std::this_thread::get_id();
+      for (int i = from; i < to; ++i) marks[i]++;
+    });
+  }
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first[0], first[1]);
+  EXPECT_NE(first[0], std::this_thread::get_id());
+  for (int mark : marks) EXPECT_EQ(mark, 2);
+
+  // Из задачи пула вызов не блокирует очередь собственного потока
+  std::promise<int> nested;
+  executor.Submit([&executor, &nested] {
+    std::atomic<int> count(0);
+    executor.ParallelForStatic(0, 100, [&count](int from, int to) {
+      count += to - from;
+    });
+    nested.set_value(count);
+  });
+  EXPECT_EQ(nested.get_future().get(), 100);
+
+  // Часть потока, занятого долгой задачей, не ждёт её окончания
+  std::promise<void> started;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  executor.Submit([&started, released] {
+    started.set_value();
+    released.wait();
+  });
+  started.get_future().wait();
+  std::atomic<int> count(0);
+  for (int round = 0; round < 8; ++round) {
+    executor.ParallelForStatic(0, 100, [&count](int from, int to) {
+      count += to - from;
+    });
+  }
+  release.set_value();
+  EXPECT_EQ(count, 800);
+  EXPECT_THROW(executor.ParallelForStatic(0, 10,
+                                          [](int, int) {
+                                            throw std::runtime_error("failure");
+                                          }),
+               std::runtime_error);
+}
+
+// Тесты для сравнения с допуском и хеша
+TEST(EqMatrixTest, Tolerance) {
+  S21Matrix matrix1 = MakeSequence(3, 3, 1.0);
+  S21Matrix matrix2 = MakeSequence(3, 3, 1.0);
+  matrix2(1, 1) += 1e-9;
+
+  EXPECT_FALSE(matrix1.EqMatrix(matrix2));
+  EXPECT_TRUE(matrix1.EqMatrix(matrix2, 1e-8));
+  EXPECT_FALSE(matrix1.EqMatrix(matrix2, 1e-10));
+  EXPECT_TRUE(matrix1.EqMatrix(matrix2, 0.0, 1e-9));
+  EXPECT_FALSE(matrix1.EqMatrix(S21Matrix(3, 2), 1.0));
+}
+
+TEST(EqMatrixTest, Ulp) {
+  S21Matrix matrix1(2, 2);
+  S21Matrix matrix2(2, 2);
+  matrix2(0, 0) = std::nextafter(std::nextafter(2.0, 3.0), 3.0);
+  matrix1(1, 1) = 0.0;
+  matrix2(1, 1) = -0.0;
+
+  EXPECT_FALSE(matrix1.EqMatrixUlp(matrix2, 1));
+  EXPECT_TRUE(matrix1.EqMatrixUlp(matrix2, 2));
+
+  matrix2(0, 0) = NAN;
+  EXPECT_FALSE(matrix2.EqMatrixUlp(matrix2, 100));
+}
+
+TEST(EqMatrixTest, CachedHash) {
+  S21Matrix matrix1 = MakeSequence(100, 100, 0.0);
+  S21Matrix matrix2 = MakeSequence(100, 100, 0.0);
+  matrix1(0, 0) = 0.0;
+  matrix2(0, 0) = -0.0;
+
+  EXPECT_EQ(matrix1.GetHash(), matrix2.GetHash());
+  EXPECT_TRUE(matrix1 == matrix2);
+
+  // Изменение через operator() сбрасывает кеш
+  matrix2(99, 99) = 1.0;
+  EXPECT_NE(matrix1.GetHash(), matrix2.GetHash());
+  EXPECT_FALSE(matrix1 == matrix2);
+
+  matrix2.SetRows(99);
+  matrix1.SetRows(99);
+  EXPECT_EQ(matrix1.GetHash(), matrix2.GetHash());
+  EXPECT_TRUE(matrix1 == matrix2);
+}
+
+TEST(EqMatrixTest, RetainedPointer) {
+  S21Matrix matrix1 = MakeSequence(100, 100, 0.0);
+  S21Matrix matrix2 = MakeSequence(100, 100, 0.0);
+  double* data = matrix2.Data();
+  EXPECT_TRUE(matrix1 == matrix2);
+
+  // Запись через указатель из Data после сравнения не оставляет
+  // устаревшего хеша
+  data[5 * matrix2.GetStride() + 5] = 7.0;
+  EXPECT_FALSE(matrix1 == matrix2);
+  matrix1(5, 5) = 7.0;
+  EXPECT_TRUE(matrix1 == matrix2);
+  EXPECT_EQ(matrix1.GetHash(), matrix2.GetHash());
+}
+
+TEST(EqMatrixTest, ComparisonFillsHash) {
+  S21Matrix matrix1 = MakeSequence(50, 50, 0.0);
+  S21Matrix matrix2 = MakeSequence(50, 50, 0.0);
+  EXPECT_TRUE(matrix1 == matrix2);
+  EXPECT_TRUE(matrix2 == matrix1);
+
+  // Новая версия после записи сравнивается заново
+  matrix2(49, 49) = -1.0;
+  EXPECT_FALSE(matrix1 == matrix2);
+  matrix2.Set(49, 49, matrix1(49, 49));
+  EXPECT_TRUE(matrix1 == matrix2);
+
+  S21Matrix copy(matrix1);
+  EXPECT_EQ(copy.GetHash(), matrix1.GetHash());
+  EXPECT_TRUE(copy == matrix2);
+
+  // Кешированные хеши с NaN не дают равенства
+  matrix1(0, 0) = NAN;
+  matrix2(0, 0) = NAN;
+  EXPECT_EQ(matrix1.GetHash(), matrix2.GetHash());
+  EXPECT_FALSE(matrix1 == matrix2);
+}
+
+TEST(EqMatrixTest, Infinities) {
+  S21Matrix matrix1(2, 2);
+  S21Matrix matrix2(2, 2);
+  matrix1(0, 0) = INFINITY;
+  matrix2(0, 0) = INFINITY;
+
+  EXPECT_TRUE(matrix1.EqMatrix(matrix2, 1e-9, 1e-9));
+  matrix2(0, 0) = -INFINITY;
+  EXPECT_FALSE(matrix1.EqMatrix(matrix2, 1e-9, 1e-9));
+  EXPECT_THROW(matrix1.EqMatrixUlp(matrix2, -1), std::invalid_argument);
+}
+
+TEST(EqMatrixTest, NanIsNeverEqual) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 1) = NAN;
+  matrix.GetHash();
+
+  EXPECT_FALSE(matrix == matrix);
+  EXPECT_FALSE(matrix.EqMatrix(matrix, 1.0));
+}
+
+TEST(S21MatrixCowTests, DecompositionKeepsSource) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix a = Pseudorandom(4, 3, 8);
+  S21Matrix copy(a);
+  S21MatrixDecomposition::HouseholderQR(a);
+  S21MatrixDecomposition::JacobiSVD(a.Transpose());
+  S21Matrix::SetCopyOnWrite(false);
+
+  EXPECT_TRUE(a == copy);
+  EXPECT_TRUE(a == Pseudorandom(4, 3, 8));
+}
+
+TEST(S21MatrixDecompositionTests, PartialPivotLU) {
+  S21Matrix a = Pseudorandom(6, 6, 9);
+  S21MatrixDecomposition::LU lu = S21MatrixDecomposition::PartialPivotLU(a);
+  // Разложение по первой строке через алгебраические дополнения
+  S21Matrix complements = a.CalcComplements();
+  double cofactor = 0;
+  for (int j = 0; j < 6; ++j) cofactor += a(0, j) * complements(0, j);
+
+  EXPECT_NEAR(S21MatrixDecomposition::Determinant(lu), cofactor, 1e-12);
+  EXPECT_NEAR(a.Determinant(), cofactor, 1e-12);
+  EXPECT_LT(MaxDifference(a * a.InverseMatrix(), S21Matrix::Identity(6)),
+            1e-12);
+  EXPECT_THROW(S21Matrix(5, 5).InverseMatrix(), std::runtime_error);
+}
+
+// Тесты для кеша разложений
+TEST(S21MatrixCacheTests, HitsAndInvalidation) {
+  S21MatrixCache& cache = S21MatrixCache::Instance();
+  cache.Enable(1 << 20);
+  cache.ResetStats();
+  S21Matrix a = Pseudorandom(5, 5, 10);
+
+  double det = a.Determinant();
+  S21Matrix inverse = a.InverseMatrix();
+  // Обращение переиспользует LU-разложение, построенное для определителя,
+  // но в статистике это один промах на операцию
+  EXPECT_EQ(cache.GetStats().entries, 1);
+  EXPECT_EQ(cache.GetStats().hits, 0);
+  EXPECT_EQ(cache.GetStats().misses, 2);
+  EXPECT_EQ(a.Determinant(), det);
+  EXPECT_TRUE(a.InverseMatrix() == inverse);
+  EXPECT_EQ(cache.GetStats().hits, 2);
+  EXPECT_EQ(cache.GetStats().misses, 2);
+
+  // Изменённая матрица не находит старую запись
+  a(2, 3) += 1.0;
+  EXPECT_NE(a.Determinant(), det);
+  EXPECT_FALSE(a.InverseMatrix() == inverse);
+  EXPECT_EQ(cache.GetStats().hits, 2);
+  EXPECT_EQ(cache.GetStats().misses, 4);
+  EXPECT_EQ(cache.GetStats().entries, 2);
+
+  cache.Clear();
+  cache.Disable();
+}
+
+TEST(S21MatrixCacheTests, Eviction) {
+  S21MatrixCache& cache = S21MatrixCache::Instance();
+  cache.Enable(4096);
+  cache.ResetStats();
+
+  for (int seed = 0; seed < 8; ++seed) Pseudorandom(8, 8, seed).Determinant();
+  S21MatrixCache::Stats stats = cache.GetStats();
+  EXPECT_GT(stats.evictions, 0);
+  EXPECT_LE(stats.bytes, 4096u);
+
+  cache.Disable();
+  EXPECT_EQ(cache.GetStats().entries, 0);
+  EXPECT_EQ(cache.GetStats().bytes, 0u);
+  Pseudorandom(8, 8, 0).Determinant();
+  EXPECT_EQ(cache.GetStats().entries, 0);
+}
+
+// Тесты для размещения по узлам NUMA
+TEST(S21MatrixNumaTests, Topology) {
+  int nodes = S21MatrixNuma::GetNodeCount();
+  EXPECT_GE(nodes, 1);
+  EXPECT_EQ(S21MatrixNuma::GetPlacement(),
+            S21MatrixNuma::Placement::kFirstTouch);
+
+  std::vector<double> data(1 << 16);
+  EXPECT_FALSE(S21MatrixNuma::Place(data.data(), data.size()));
+  if (nodes == 1) {
+    // На одном узле политика и привязка ничего не меняют
+    S21MatrixNuma::SetPlacement(S21MatrixNuma::Placement::kInterleave);
+    EXPECT_FALSE(S21MatrixNuma::Place(data.data(), data.size()));
+    S21MatrixNuma::SetPlacement(S21MatrixNuma::Placement::kFirstTouch);
+    EXPECT_FALSE(S21MatrixNuma::PinThread(0));
+  }
+}
+
+TEST(S21MatrixNumaTests, ParallelInitialization) {
+  for (S21MatrixNuma::Placement placement :
+       {S21MatrixNuma::Placement::kFirstTouch,
+        S21MatrixNuma::Placement::kInterleave,
+        S21MatrixNuma::Placement::kLocal}) {
+    S21MatrixNuma::SetPlacement(placement);
+    S21Matrix matrix(300, 400);
+    S21MatrixNuma::SetPlacement(S21MatrixNuma::Placement::kFirstTouch);
+
+    double sum = 0;
+    for (int i = 0; i < matrix.GetRows(); ++i) {
+      for (int j = 0; j < matrix.GetCols(); ++j) sum += matrix(i, j);
+    }
+    EXPECT_EQ(sum, 2.0 * 300 * 400);
+
+    matrix(299, 399) = 5.0;
+    S21Matrix copy(matrix);
+    EXPECT_TRUE(copy == matrix);
+    copy.SetCols(500);
+    EXPECT_EQ(copy(299, 399), 5.0);
+    EXPECT_EQ(copy(299, 499), 0.0);
+  }
+}
+
+TEST(S21MatrixNumaTests, Placement) {
+  std::vector<double> probe(1, 0.0);
+  if (S21MatrixNuma::GetNode(probe.data()) < 0) {
+    GTEST_SKIP() << "Page placement cannot be queried";
+  }
+  int nodes = S21MatrixNuma::GetNodeCount();
+  int threads = S21MatrixExecutor::Instance().GetThreadCount();
+  // Можно ли привязывать потоки к узлам в этом окружении
+  bool pinned = false;
+  std::thread([&pinned] { pinned = S21MatrixNuma::PinThread(0); }).join();
+  // 64 МиБ больше порога mmap в glibc, поэтому страницы всегда новые
+  const int rows = 4096;
+  const int cols = 2048;
+  for (S21MatrixNuma::Placement placement :
+       {S21MatrixNuma::Placement::kFirstTouch,
+        S21MatrixNuma::Placement::kInterleave,
+        S21MatrixNuma::Placement::kLocal}) {
+    std::vector<int> found;
+    int callerNode = -1;
+    // Матрица создаётся в потоке, привязанном к узлу 0
+    std::thread([&] {
+      S21MatrixNuma::PinThread(0);
+      callerNode = S21MatrixNuma::GetCurrentNode();
+      S21MatrixNuma::SetPlacement(placement);
+      const S21Matrix matrix = S21Matrix::Filled(rows, cols, 1.0);
+      S21MatrixNuma::SetPlacement(S21MatrixNuma::Placement::kFirstTouch);
+      // Середина части строк, которую заполнял каждый поток пула
+      for (int part = 0; part < threads; ++part) {
+        int row = static_cast<int>((2LL * part + 1) * rows / (2 * threads));
+        found.push_back(S21MatrixNuma::GetNode(&matrix(row, cols / 2)));
+      }
+    }).join();
+
+    for (int part = 0; part < threads; ++part) {
+      EXPECT_GE(found[part], 0);
+      EXPECT_LT(found[part], nodes);
+      if (nodes == 1) {
+        EXPECT_EQ(found[part], 0);
+      } else if (pinned &&
+                 placement == S21MatrixNuma::Placement::kFirstTouch) {
+        // Часть заполняет поток с тем же номером, привязанный к узлу
+        EXPECT_EQ(found[part], part % nodes);
+      } else if (pinned && placement == S21MatrixNuma::Placement::kLocal) {
+        EXPECT_EQ(found[part], callerNode);
+      }
+    }
+  }
+}
+
+// Тесты для фабрик
+TEST(S21MatrixFactoryTests, Factories) {
+  S21Matrix zeros = S21Matrix::Zeros(400, 300);
+  S21Matrix filled = S21Matrix::Filled(400, 300, -1.5);
+  S21Matrix identity = S21Matrix::Identity(4);
+  S21Matrix uninitialized = S21Matrix::Uninitialized(2, 3);
+
+  EXPECT_EQ(zeros.GetRows(), 400);
+  EXPECT_EQ(zeros.GetCols(), 300);
+  EXPECT_EQ(uninitialized.GetRows(), 2);
+  EXPECT_EQ(uninitialized.GetCols(), 3);
+  double zerosSum = 0;
+  double filledSum = 0;
+  for (int i = 0; i < 400; ++i) {
+    for (int j = 0; j < 300; ++j) {
+      zerosSum += std::abs(zeros(i, j));
+      filledSum += filled(i, j);
+    }
+  }
+  EXPECT_EQ(zerosSum, 0.0);
+  EXPECT_EQ(filledSum, -1.5 * 400 * 300);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) EXPECT_EQ(identity(i, j), i == j ? 1 : 0);
+  }
+  EXPECT_TRUE(S21Matrix::Filled(3, 3, 2.0) == S21Matrix(3, 3));
+  EXPECT_THROW(S21Matrix::Zeros(0, 3), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Identity(-1), std::invalid_argument);
+}
+
+TEST(S21MatrixFactoryTests, ResultsOverwriteEveryElement) {
+  S21Matrix a = Pseudorandom(5, 4, 11);
+  S21Matrix b = Pseudorandom(4, 6, 12);
+  S21Matrix product = a * b;
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      double sum = 0;
+      for (int k = 0; k < 4; ++k) sum += a(i, k) * b(k, j);
+      EXPECT_DOUBLE_EQ(product(i, j), sum);
+    }
+  }
+  EXPECT_TRUE(a.Transpose().Transpose() == a);
+  EXPECT_TRUE(S21Matrix(a) == a);
+  EXPECT_TRUE(S21Matrix::Identity(4) * b == b);
+}
+
+// Тесты для генераторов случайных матриц
+TEST(S21MatrixRandomTests, Reproducible) {
+  S21MatrixRandom first(42);
+  S21MatrixRandom second(42);
+  S21Matrix uniform = first.Uniform(300, 300, 2.0, 3.0);
+
+  EXPECT_TRUE(uniform == second.Uniform(300, 300, 2.0, 3.0));
+  EXPECT_FALSE(first.Uniform(300, 300, 2.0, 3.0) == uniform);
+  EXPECT_FALSE(S21MatrixRandom(43).Uniform(300, 300, 2.0, 3.0) == uniform);
+  // Строки большой и маленькой матрицы с тем же номером вызова совпадают
+  S21Matrix small = S21MatrixRandom(42).Uniform(2, 300, 2.0, 3.0);
+  for (int j = 0; j < 300; ++j) EXPECT_EQ(small(1, j), uniform(1, j));
+
+  double sum = 0;
+  for (int i = 0; i < 300; ++i) {
+    for (int j = 0; j < 300; ++j) {
+      EXPECT_GE(uniform(i, j), 2.0);
+      EXPECT_LT(uniform(i, j), 3.0);
+      sum += uniform(i, j);
+    }
+  }
+  EXPECT_NEAR(sum / (300 * 300), 2.5, 0.01);
+}
+
+TEST(S21MatrixRandomTests, Gaussian) {
+  S21Matrix gaussian = S21MatrixRandom(7).Gaussian(400, 250, 1.0, 2.0);
+  double sum = 0;
+  double squares = 0;
+  for (int i = 0; i < 400; ++i) {
+    for (int j = 0; j < 250; ++j) {
+      sum += gaussian(i, j);
+      squares += gaussian(i, j) * gaussian(i, j);
+    }
+  }
+  double mean = sum / (400 * 250);
+  EXPECT_NEAR(mean, 1.0, 0.02);
+  EXPECT_NEAR(squares / (400 * 250) - mean * mean, 4.0, 0.1);
+}
+
+TEST(S21MatrixRandomTests, StructuredMatrices) {
+  S21MatrixRandom random(5);
+  S21Matrix q = random.Orthogonal(12);
+  EXPECT_LT(MaxDifference(q.Transpose() * q, S21Matrix::Identity(12)), 1e-12);
+
+  S21Matrix spd = random.Spd(10, 100.0);
+  S21MatrixDecomposition::Eigen eigen =
+      S21MatrixDecomposition::SymmetricEigen(spd);
+  EXPECT_NEAR(eigen.values(0, 0), 0.1, 1e-12);
+  EXPECT_NEAR(eigen.values(9, 0), 10.0, 1e-12);
+  EXPECT_NEAR(spd.Determinant(), 1.0, 1e-10);
+
+  S21Matrix conditioned = random.WithCondition(8, 1e6);
+  S21Matrix sigma = S21MatrixDecomposition::JacobiSVD(conditioned).sigma;
+  EXPECT_NEAR(sigma(0, 0) / sigma(7, 0), 1e6, 1e-3);
+  EXPECT_NEAR(std::abs(conditioned.Determinant()), 1.0, 1e-8);
+
+  S21Matrix banded = random.Banded(6, 7, 1, 2);
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      if (j < i - 1 || j > i + 2) {
+        EXPECT_EQ(banded(i, j), 0.0);
+      } else if (j == i) {
+        EXPECT_NE(banded(i, j), 0.0);
+      }
+    }
+  }
+  EXPECT_THROW(random.Spd(3, 0.5), std::invalid_argument);
+  EXPECT_THROW(random.Banded(3, 3, -1, 0), std::invalid_argument);
+}
+
+// Тесты для ленточных и блочно-диагональных матриц
+TEST(S21BandedMatrixTests, Conversion) {
+  S21Matrix dense = S21MatrixRandom(13).Banded(7, 7, 2, 1);
+  S21BandedMatrix banded = S21BandedMatrix::FromMatrix(dense);
+  const S21BandedMatrix& view = banded;
+
+  EXPECT_EQ(banded.GetSize(), 7);
+  EXPECT_EQ(banded.GetLower(), 2);
+  EXPECT_EQ(banded.GetUpper(), 1);
+  EXPECT_TRUE(banded.ToMatrix() == dense);
+  EXPECT_EQ(view(6, 0), 0.0);
+  EXPECT_THROW(banded(0, 2) = 1.0, std::out_of_range);
+  EXPECT_THROW(view(7, 0), std::out_of_range);
+  banded(3, 4) = 5.0;
+  EXPECT_EQ(banded.ToMatrix()(3, 4), 5.0);
+  EXPECT_EQ(S21BandedMatrix(3, 10, 0).GetLower(), 2);
+  EXPECT_THROW(S21BandedMatrix(3, -1, 0), std::invalid_argument);
+}
+
+TEST(S21BandedMatrixTests, Multiply) {
+  S21MatrixRandom random(14);
+  S21Matrix a = random.Banded(9, 9, 1, 2);
+  S21Matrix b = random.Banded(9, 9, 2, 0);
+  S21BandedMatrix product =
+      S21BandedMatrix::FromMatrix(a) * S21BandedMatrix::FromMatrix(b);
+
+  EXPECT_EQ(product.GetLower(), 3);
+  EXPECT_EQ(product.GetUpper(), 2);
+  EXPECT_LT(MaxDifference(product.ToMatrix(), a * b), 1e-14);
+  S21Matrix x = random.Uniform(9, 4);
+  EXPECT_LT(MaxDifference(S21BandedMatrix::FromMatrix(a).Multiply(x), a * x),
+            1e-14);
+  std::vector<double> vector(9, 1.0);
+  std::vector<double> y = S21BandedMatrix::FromMatrix(a).Multiply(vector);
+  for (int i = 0; i < 9; ++i) {
+    double sum = 0;
+    for (int j = 0; j < 9; ++j) sum += a(i, j);
+    EXPECT_NEAR(y[i], sum, 1e-14);
+  }
+}
+
+TEST(S21BandedMatrixTests, SolveAndDeterminant) {
+  // Лента без диагонального преобладания требует выбора ведущего элемента
+  S21Matrix dense = S21MatrixRandom(15).Banded(12, 12, 2, 2);
+  dense(0, 0) = 0.0;
+  S21BandedMatrix banded = S21BandedMatrix::FromMatrix(dense);
+  std::vector<double> rhs(12);
+  for (int i = 0; i < 12; ++i) rhs[i] = i - 5.5;
+
+  std::vector<double> x = banded.Solve(rhs);
+  std::vector<double> check = banded.Multiply(x);
+  for (int i = 0; i < 12; ++i) EXPECT_NEAR(check[i], rhs[i], 1e-10);
+  EXPECT_NEAR(banded.Determinant(), dense.Determinant(),
+              1e-12 * std::abs(dense.Determinant()));
+
+  S21BandedMatrix singular(4, 1, 1);
+  singular(0, 0) = 1.0;
+  EXPECT_EQ(singular.Determinant(), 0.0);
+  EXPECT_THROW(singular.Solve(std::vector<double>(4, 1.0)),
+               std::runtime_error);
+}
+
+TEST(S21BandedMatrixTests, LargeTridiagonal) {
+  // Разностная схема для -u'' = 1 на миллионе узлов решается прогонкой
+  int n = 1000000;
+  S21BandedMatrix laplace(n, 1, 1);
+  for (int i = 0; i < n; ++i) {
+    laplace(i, i) = 2.0 + 1e-3;
+    if (i > 0) laplace(i, i - 1) = -1.0;
+    if (i + 1 < n) laplace(i, i + 1) = -1.0;
+  }
+  std::vector<double> rhs(n, 1.0);
+  std::vector<double> x = laplace.Solve(rhs);
+  std::vector<double> check = laplace.Multiply(x);
+  double residual = 0;
+  for (int i = 0; i < n; ++i) {
+    residual = std::max(residual, std::abs(check[i] - rhs[i]));
+  }
+  EXPECT_LT(residual, 1e-9);
+
+  // То же решение через LU с выбором ведущего элемента
+  std::vector<double> pivoted =
+      S21BandedMatrix::Solve(laplace.Factorize(), rhs);
+  EXPECT_NEAR(pivoted[n / 2], x[n / 2], 1e-9 * std::abs(x[n / 2]));
+}
+
+TEST(S21BlockDiagonalMatrixTests, Operations) {
+  S21MatrixRandom random(16);
+  S21BlockDiagonalMatrix matrix(
+      {random.WithCondition(3, 5.0), random.WithCondition(1, 1.0),
+       random.Spd(4, 10.0)});
+  S21Matrix dense = matrix.ToMatrix();
+
+  EXPECT_EQ(matrix.GetSize(), 8);
+  EXPECT_EQ(matrix.GetBlockCount(), 3);
+  EXPECT_EQ(matrix.GetOffset(2), 4);
+  EXPECT_THROW(matrix.GetBlock(3), std::out_of_range);
+  EXPECT_EQ(dense(0, 5), 0.0);
+
+  S21BlockDiagonalMatrix restored = S21BlockDiagonalMatrix::FromMatrix(dense);
+  EXPECT_EQ(restored.GetBlockCount(), 3);
+  EXPECT_TRUE(restored.ToMatrix() == dense);
+
+  EXPECT_NEAR(matrix.Determinant(), dense.Determinant(), 1e-12);
+  EXPECT_LT(MaxDifference(matrix.InverseMatrix().ToMatrix(),
+                          dense.InverseMatrix()),
+            1e-12);
+  EXPECT_LT(MaxDifference((matrix * matrix).ToMatrix(), dense * dense),
+            1e-14);
+  S21Matrix x = random.Uniform(8, 3);
+  EXPECT_LT(MaxDifference(matrix.Multiply(x), dense * x), 1e-14);
+  EXPECT_THROW(matrix.AddBlock(S21Matrix(2, 3)), std::invalid_argument);
+  EXPECT_EQ(S21Matrix::Filled(1, 1, 4.0).InverseMatrix()(0, 0), 0.25);
+}
+
+TEST(S21MatrixWrapTests, SharesCallerBuffer) {
+  // Матрица 2x3 поверх буфера с шагом 4, последний столбец - отступ
+  std::vector<double> buffer = {1, 2, 3, -1, 4, 5, 6, -1};
+  S21Matrix matrix = S21Matrix::Wrap(buffer.data(), 2, 3, 4);
+  EXPECT_EQ(matrix.GetStride(), 4);
+  EXPECT_EQ(matrix(1, 0), 4.0);
+
+  matrix(0, 1) = 7;
+  EXPECT_EQ(buffer[1], 7.0);
+  // Изменения извне видны без устаревшего хеша
+  S21Matrix copy = matrix;
+  buffer[5] = 8;
+  EXPECT_EQ(matrix(1, 1), 8.0);
+  EXPECT_FALSE(matrix == copy);
+  EXPECT_EQ(buffer[3], -1.0);
+
+  // Копия обёртки всегда глубокая, даже с копированием при записи
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix shared = matrix;
+  S21Matrix::SetCopyOnWrite(false);
+  buffer[0] = 9;
+  EXPECT_EQ(shared(0, 0), 1.0);
+
+  S21Matrix product = matrix * S21Matrix::Identity(3);
+  EXPECT_TRUE(product == matrix);
+  EXPECT_THROW(S21Matrix::Wrap(buffer.data(), 2, 3, 2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Wrap(nullptr, 2, 3, 3), std::invalid_argument);
+}
+
+TEST(S21MatrixWrapTests, ResizeKeepsCallerBuffer) {
+  std::vector<double> buffer = {1, 2, 3, -1, 4, 5, 6, -1};
+  const std::vector<double> original = buffer;
+  S21Matrix wide = S21Matrix::Wrap(buffer.data(), 2, 3, 4);
+  // Рост в пределах шага не должен обнулять отступ вызывающего
+  wide.SetCols(4);
+  EXPECT_EQ(wide(1, 3), 0.0);
+  EXPECT_EQ(wide(1, 2), 6.0);
+
+  S21Matrix tall = S21Matrix::Wrap(buffer.data(), 2, 3, 4);
+  tall.SetRows(1);
+  tall.SetRows(2);
+  EXPECT_EQ(tall(1, 0), 0.0);
+  S21Matrix appended = S21Matrix::Wrap(buffer.data(), 2, 3, 4);
+  appended.SetRows(1);
+  appended.AppendRow({7, 8, 9});
+  EXPECT_EQ(appended(1, 1), 8.0);
+  EXPECT_EQ(buffer, original);
+
+  // После переноса запись в матрицу не видна в буфере
+  wide(0, 0) = 10;
+  EXPECT_EQ(buffer[0], 1.0);
+}
+
+TEST(S21MatrixWrapTests, CapacityCalls) {
+  std::vector<double> buffer = {1, 2, 3, -1, 4, 5, 6, -1};
+  S21Matrix matrix = S21Matrix::Wrap(buffer.data(), 2, 3, 4);
+  // ShrinkToFit не уводит обёртку из буфера вызывающего
+  matrix.ShrinkToFit();
+  EXPECT_EQ(matrix.GetStride(), 4);
+  matrix(1, 2) = 7;
+  EXPECT_EQ(buffer[6], 7.0);
+  // Reserve в пределах буфера ничего не переносит
+  matrix.Reserve(2, 4);
+  matrix(0, 0) = 8;
+  EXPECT_EQ(buffer[0], 8.0);
+  // Reserve сверх буфера переносит данные в собственную память
+  matrix.Reserve(4, 4);
+  EXPECT_EQ(matrix.GetCapacity(), 4);
+  matrix(0, 0) = 9;
+  EXPECT_EQ(buffer[0], 8.0);
+  EXPECT_EQ(matrix(1, 2), 7.0);
+}
+
+TEST(S21MatrixCTests, Operations) {
+  EXPECT_EQ(s21_matrix_abi_version(), S21_MATRIX_ABI_VERSION);
+  double data[] = {4, 7, 2, 6};
+  s21_matrix* matrix = nullptr;
+  ASSERT_EQ(s21_matrix_wrap(data, 2, 2, 2, &matrix), S21_MATRIX_OK);
+  EXPECT_EQ(s21_matrix_rows(matrix), 2);
+  EXPECT_EQ(s21_matrix_data(matrix), data);
+
+  double determinant = 0;
+  EXPECT_EQ(s21_matrix_determinant(matrix, &determinant), S21_MATRIX_OK);
+  EXPECT_NEAR(determinant, 10.0, 1e-12);
+  s21_matrix* inverse = nullptr;
+  ASSERT_EQ(s21_matrix_inverse(matrix, &inverse), S21_MATRIX_OK);
+  s21_matrix* product = nullptr;
+  ASSERT_EQ(s21_matrix_multiply(matrix, inverse, &product), S21_MATRIX_OK);
+  const double* identity = s21_matrix_data(product);
+  int stride = s21_matrix_stride(product);
+  EXPECT_NEAR(identity[0], 1.0, 1e-12);
+  EXPECT_NEAR(identity[1], 0.0, 1e-12);
+  EXPECT_NEAR(identity[stride + 1], 1.0, 1e-12);
+
+  s21_matrix* wide = nullptr;
+  ASSERT_EQ(s21_matrix_create(3, 4, &wide), S21_MATRIX_OK);
+  s21_matrix* result = nullptr;
+  EXPECT_EQ(s21_matrix_multiply(wide, matrix, &result),
+            S21_MATRIX_INVALID_ARGUMENT);
+  EXPECT_EQ(result, nullptr);
+  EXPECT_STRNE(s21_matrix_last_error(), "");
+  EXPECT_EQ(s21_matrix_create(0, 1, &result), S21_MATRIX_INVALID_ARGUMENT);
+  EXPECT_EQ(s21_matrix_inverse(nullptr, &result),
+            S21_MATRIX_INVALID_ARGUMENT);
+  data[0] = 0;
+  data[1] = 0;
+  EXPECT_EQ(s21_matrix_inverse(matrix, &result), S21_MATRIX_RUNTIME_ERROR);
+
+  s21_matrix_free(wide);
+  s21_matrix_free(product);
+  s21_matrix_free(inverse);
+  s21_matrix_free(matrix);
+  s21_matrix_free(nullptr);
+}